@@ -0,0 +1,241 @@
+#include "asset_archive.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char* const AssetArchive::DEFAULT_PATH = "dependencies/assets.pak";
+const char AssetArchive::MAGIC[4] = { 'A', 'P', 'A', 'K' };
+const std::uint32_t AssetArchive::VERSION = 1;
+
+AssetArchive::AssetArchive() : mData(nullptr), mSize(0), mFileHandle(nullptr), mMappingHandle(nullptr) {}
+
+AssetArchive::~AssetArchive()
+{
+    close();
+}
+
+bool AssetArchive::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+        {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+
+    if (!view)
+    {
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        std::cout << "Failed to map asset archive: " << path << std::endl;
+        return false;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mData = static_cast<const char*>(view);
+    mSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileInfo;
+    void* view = MAP_FAILED;
+    if (fstat(file, &fileInfo) == 0 && fileInfo.st_size > 0)
+    {
+        view = mmap(nullptr, static_cast<std::size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file); // The mapping keeps its own reference to the file
+
+    if (view == MAP_FAILED)
+    {
+        std::cout << "Failed to map asset archive: " << path << std::endl;
+        return false;
+    }
+
+    mData = static_cast<const char*>(view);
+    mSize = static_cast<std::size_t>(fileInfo.st_size);
+#endif
+
+    if (!readIndex())
+    {
+        std::cout << "Asset archive is corrupt or from another version: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    std::cout << "Mounted asset archive " << path << " (" << mEntries.size() << " entries)" << std::endl;
+    return true;
+}
+
+void AssetArchive::close()
+{
+    mEntries.clear();
+    if (!mData)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(mData);
+    CloseHandle(static_cast<HANDLE>(mMappingHandle));
+    CloseHandle(static_cast<HANDLE>(mFileHandle));
+#else
+    munmap(const_cast<char*>(mData), mSize);
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+    mFileHandle = nullptr;
+    mMappingHandle = nullptr;
+}
+
+bool AssetArchive::find(const std::string& name, const void*& data, std::size_t& size) const
+{
+    auto it = mEntries.find(name);
+    if (it == mEntries.end())
+    {
+        return false;
+    }
+
+    data = mData + it->second.offset;
+    size = static_cast<std::size_t>(it->second.size);
+    return true;
+}
+
+bool AssetArchive::readIndex()
+{
+    std::size_t position = 0;
+    auto read = [this, &position](void* destination, std::size_t bytes)
+    {
+        if (mSize - position < bytes)
+        {
+            return false;
+        }
+        std::memcpy(destination, mData + position, bytes);
+        position += bytes;
+        return true;
+    };
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t entryCount = 0;
+    if (!read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !read(&version, sizeof(version)) || version != VERSION ||
+        !read(&entryCount, sizeof(entryCount)))
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < entryCount; ++i)
+    {
+        std::uint32_t nameLength = 0;
+        if (!read(&nameLength, sizeof(nameLength)) || mSize - position < nameLength)
+        {
+            return false;
+        }
+        std::string name(mData + position, nameLength);
+        position += nameLength;
+
+        Entry entry;
+        if (!read(&entry.offset, sizeof(entry.offset)) || !read(&entry.size, sizeof(entry.size)) ||
+            entry.offset > mSize || entry.size > mSize - entry.offset)
+        {
+            return false;
+        }
+        mEntries[name] = entry;
+    }
+
+    return true;
+}
+
+bool AssetArchive::pack(const std::vector<std::string>& files, const std::string& outputPath)
+{
+    std::vector<std::vector<char>> contents;
+    for (const std::string& file : files)
+    {
+        std::ifstream input(file, std::ios::binary);
+        if (!input)
+        {
+            std::cout << "Failed to read " << file << " for packing" << std::endl;
+            return false;
+        }
+        contents.emplace_back(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    // The index size has to be known before the first data offset
+    std::uint64_t offset = sizeof(MAGIC) + sizeof(VERSION) + sizeof(std::uint32_t);
+    for (const std::string& file : files)
+    {
+        offset += sizeof(std::uint32_t) + file.size() + 2 * sizeof(std::uint64_t);
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        std::cout << "Failed to create " << outputPath << std::endl;
+        return false;
+    }
+
+    std::uint32_t entryCount = static_cast<std::uint32_t>(files.size());
+    output.write(MAGIC, sizeof(MAGIC));
+    output.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    output.write(reinterpret_cast<const char*>(&entryCount), sizeof(entryCount));
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        std::uint32_t nameLength = static_cast<std::uint32_t>(files[i].size());
+        std::uint64_t size = contents[i].size();
+        output.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        output.write(files[i].data(), nameLength);
+        output.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        output.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        offset += size;
+    }
+
+    for (const std::vector<char>& content : contents)
+    {
+        output.write(content.data(), content.size());
+    }
+
+    if (!output)
+    {
+        std::cout << "Failed to write " << outputPath << std::endl;
+        return false;
+    }
+
+    std::cout << "Packed " << files.size() << " files into " << outputPath << std::endl;
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Read-only pack of asset files, memory-mapped so assets can be decoded straight from
+// the mapping. Layout: "APAK", version, entry count, then per entry the path length,
+// path, offset and size, followed by the raw file contents. Offsets are from the start
+// of the file. Entries are looked up by the same relative path the loose file has.
+class AssetArchive
+{
+public:
+    AssetArchive();
+    ~AssetArchive();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mData != nullptr; }
+
+    // Points into the mapping, valid until close. Returns false if the entry is missing.
+    bool find(const std::string& name, const void*& data, std::size_t& size) const;
+
+    // Build step: packs the given files, stored under the paths passed in
+    static bool pack(const std::vector<std::string>& files, const std::string& outputPath);
+
+    static const char* const DEFAULT_PATH;
+
+private:
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool readIndex();
+
+    struct Entry
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    std::unordered_map<std::string, Entry> mEntries;
+    const char* mData;
+    std::size_t mSize;
+
+    // Platform handles for the mapping
+    void* mFileHandle;
+    void* mMappingHandle;
+
+    static const char MAGIC[4];
+    static const std::uint32_t VERSION;
+};
+
+#endif
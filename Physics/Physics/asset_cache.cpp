@@ -0,0 +1,139 @@
+#include "asset_cache.h"
+#include <cassert>
+#include <iostream>
+
+AssetCache& AssetCache::getInstance()
+{
+    static AssetCache instance;
+    return instance;
+}
+
+AssetCache::AssetCache() : mMainThread(std::this_thread::get_id()) {}
+
+bool AssetCache::mountArchive(const std::string& path)
+{
+    return mArchive.open(path);
+}
+
+bool AssetCache::findInArchive(const std::string& path, const void*& data, std::size_t& size) const
+{
+    return mArchive.isOpen() && mArchive.find(path, data, size);
+}
+
+std::shared_ptr<const sf::Texture> AssetCache::getTexture(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mTextures.find(path);
+    if (it != mTextures.end())
+    {
+        return it->second;
+    }
+
+    const void* data = nullptr;
+    std::size_t size = 0;
+    auto texture = std::make_shared<sf::Texture>();
+    bool loaded = findInArchive(path, data, size) ? texture->loadFromMemory(data, size) : texture->loadFromFile(path);
+    if (!loaded)
+    {
+        std::cout << "Failed to load texture: " << path << std::endl;
+        return nullptr;
+    }
+
+    mTextures[path] = texture;
+    return texture;
+}
+
+bool AssetCache::hasTexture(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTextures.count(path) != 0;
+}
+
+bool AssetCache::hasGlyphAtlas(const std::string& fontPath) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mGlyphAtlases.count(fontPath) != 0;
+}
+
+void AssetCache::addTexture(const std::string& path, std::shared_ptr<const sf::Texture> texture)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTextures[path] = std::move(texture);
+}
+
+std::shared_ptr<const sf::Font> AssetCache::getFont(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mFonts.find(path);
+    if (it != mFonts.end())
+    {
+        return it->second;
+    }
+
+    const void* data = nullptr;
+    std::size_t size = 0;
+    auto font = std::make_shared<sf::Font>();
+    bool loaded = findInArchive(path, data, size) ? font->loadFromMemory(data, size) : font->loadFromFile(path);
+    if (!loaded)
+    {
+        std::cout << "Failed to load font: " << path << std::endl;
+        return nullptr;
+    }
+
+    mFonts[path] = font;
+    return font;
+}
+
+std::shared_ptr<const GlyphAtlas> AssetCache::getGlyphAtlas(const std::string& fontPath)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mGlyphAtlases.find(fontPath);
+        if (it != mGlyphAtlases.end())
+        {
+            return it->second;
+        }
+    }
+
+    assert(std::this_thread::get_id() == mMainThread);
+
+    // Built without holding the lock, getFont takes it as well
+    std::shared_ptr<const sf::Font> font = getFont(fontPath);
+    auto atlas = std::make_shared<GlyphAtlas>();
+    if (!font || !atlas->build(*font, GlyphAtlas::getDefaultSizes()))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mGlyphAtlases[fontPath] = atlas;
+    return atlas;
+}
+
+void AssetCache::releaseUnused()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mTextures.begin(); it != mTextures.end();)
+    {
+        it = it->second.use_count() == 1 ? mTextures.erase(it) : std::next(it);
+    }
+
+    for (auto it = mFonts.begin(); it != mFonts.end();)
+    {
+        it = it->second.use_count() == 1 ? mFonts.erase(it) : std::next(it);
+    }
+
+    for (auto it = mGlyphAtlases.begin(); it != mGlyphAtlases.end();)
+    {
+        it = it->second.use_count() == 1 ? mGlyphAtlases.erase(it) : std::next(it);
+    }
+}
+
+void AssetCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTextures.clear();
+    mGlyphAtlases.clear();
+    mFonts.clear();
+    mArchive.close();
+}
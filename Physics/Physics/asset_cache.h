@@ -0,0 +1,62 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "asset_archive.h"
+#include "glyph_atlas.h"
+
+// Process wide cache of textures and fonts keyed by file path. Every file is decoded
+// once and handed out as a shared handle, so menus, the HUD and levels share one copy.
+// Lookups are thread safe, but a texture that is not cached yet must be created on a
+// thread that may use OpenGL.
+class AssetCache
+{
+public:
+    static AssetCache& getInstance();
+
+    // Assets found in a mounted archive are decoded from its mapping instead of loose files.
+    // Mount before any loading starts, the archive is read without locking.
+    bool mountArchive(const std::string& path);
+    bool findInArchive(const std::string& path, const void*& data, std::size_t& size) const;
+
+    // Returns nullptr if the file could not be loaded
+    std::shared_ptr<const sf::Texture> getTexture(const std::string& path);
+    std::shared_ptr<const sf::Font> getFont(const std::string& path);
+
+    // Glyphs of the font at GlyphAtlas::getDefaultSizes. Any thread may look one up, but
+    // building it renders the font, so the first request must come from the main thread.
+    std::shared_ptr<const GlyphAtlas> getGlyphAtlas(const std::string& fontPath);
+
+    // Used by the AssetLoader to hand over textures it decoded in the background
+    bool hasTexture(const std::string& path) const;
+    bool hasGlyphAtlas(const std::string& fontPath) const;
+    void addTexture(const std::string& path, std::shared_ptr<const sf::Texture> texture);
+
+    // Drops assets nobody holds a handle to any more
+    void releaseUnused();
+
+    // Drops every cached handle and unmounts the archive, call before the window goes away so textures are not
+    // destroyed during static destruction after SFML has shut down its contexts
+    void clear();
+
+private:
+    AssetCache();
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    mutable std::mutex mMutex;
+    std::thread::id mMainThread; // The first caller of getInstance, main() mounts the archive
+    std::unordered_map<std::string, std::shared_ptr<const sf::Texture>> mTextures;
+    std::unordered_map<std::string, std::shared_ptr<const sf::Font>> mFonts;
+    std::unordered_map<std::string, std::shared_ptr<const GlyphAtlas>> mGlyphAtlases;
+
+    // Fonts loaded from the archive read their data from the mapping for as long as they live
+    AssetArchive mArchive;
+};
+
+#endif
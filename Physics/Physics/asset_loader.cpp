@@ -0,0 +1,157 @@
+#include "asset_loader.h"
+#include "asset_cache.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+AssetLoader::AssetLoader() : mStopping(false), mRequestedCount(0), mFinishedCount(0) {}
+
+AssetLoader::~AssetLoader()
+{
+    stop();
+}
+
+void AssetLoader::start(unsigned int workerCount)
+{
+    if (!mWorkers.empty())
+    {
+        return;
+    }
+
+    mStopping = false;
+    for (unsigned int i = 0; i < std::max(1u, workerCount); ++i)
+    {
+        mWorkers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+void AssetLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+        mPendingPaths.clear();
+    }
+    mWorkAvailable.notify_all();
+
+    for (std::thread& worker : mWorkers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    mWorkers.clear();
+}
+
+bool AssetLoader::requestTexture(const std::string& path)
+{
+    if (AssetCache::getInstance().hasTexture(path) ||
+        mRequestedPaths.count(path) || mFailedPaths.count(path))
+    {
+        return false;
+    }
+
+    mRequestedPaths.insert(path);
+    ++mRequestedCount;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPendingPaths.push_back(path);
+    }
+    mWorkAvailable.notify_one();
+    return true;
+}
+
+std::size_t AssetLoader::uploadCompleted(std::size_t maxUploads)
+{
+    std::size_t uploads = 0;
+    while (uploads < maxUploads)
+    {
+        DecodedImage decoded;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDecodedImages.empty())
+            {
+                break;
+            }
+            decoded = std::move(mDecodedImages.front());
+            mDecodedImages.pop_front();
+        }
+
+        mRequestedPaths.erase(decoded.path);
+        ++mFinishedCount;
+
+        if (!decoded.succeeded)
+        {
+            std::cout << "Failed to load texture: " << decoded.path << std::endl;
+            mFailedPaths.insert(decoded.path);
+            continue;
+        }
+
+        // Only the GPU upload happens here, the file was read and decoded on a worker
+        auto texture = std::make_shared<sf::Texture>();
+        if (texture->loadFromImage(decoded.image))
+        {
+            AssetCache::getInstance().addTexture(decoded.path, texture);
+        }
+        else
+        {
+            mFailedPaths.insert(decoded.path);
+        }
+        ++uploads;
+    }
+
+    if (isIdle())
+    {
+        // Start counting progress from scratch for the next batch
+        mRequestedCount = 0;
+        mFinishedCount = 0;
+    }
+
+    return uploads;
+}
+
+bool AssetLoader::isIdle() const
+{
+    return mRequestedPaths.empty();
+}
+
+float AssetLoader::getProgress() const
+{
+    return mRequestedCount == 0 ? 1.f : static_cast<float>(mFinishedCount) / mRequestedCount;
+}
+
+void AssetLoader::workerLoop()
+{
+    while (true)
+    {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkAvailable.wait(lock, [this]() { return mStopping || !mPendingPaths.empty(); });
+            if (mStopping)
+            {
+                return;
+            }
+            path = mPendingPaths.front();
+            mPendingPaths.pop_front();
+        }
+
+        DecodedImage decoded;
+        decoded.path = path;
+        const void* data = nullptr;
+        std::size_t size = 0;
+        if (AssetCache::getInstance().findInArchive(path, data, size))
+        {
+            decoded.succeeded = decoded.image.loadFromMemory(data, size);
+        }
+        else
+        {
+            decoded.succeeded = decoded.image.loadFromFile(path);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDecodedImages.push_back(std::move(decoded));
+    }
+}
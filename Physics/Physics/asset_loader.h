@@ -0,0 +1,59 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Decodes image files on worker threads. Decoded images are turned into textures on the
+// main thread, a few per frame, and handed to the AssetCache, so the window keeps
+// rendering while assets load.
+class AssetLoader
+{
+public:
+    AssetLoader();
+    ~AssetLoader();
+
+    void start(unsigned int workerCount);
+    void stop();
+
+    // Queues a texture for decoding, returns false if it is already cached, queued or failed
+    bool requestTexture(const std::string& path);
+
+    // Main thread only: uploads at most maxUploads decoded images, returns how many were uploaded
+    std::size_t uploadCompleted(std::size_t maxUploads);
+
+    bool isIdle() const;
+    float getProgress() const;
+
+private:
+    void workerLoop();
+
+    struct DecodedImage
+    {
+        std::string path;
+        sf::Image image;
+        bool succeeded;
+    };
+
+    std::vector<std::thread> mWorkers;
+    bool mStopping;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::deque<std::string> mPendingPaths;
+    std::deque<DecodedImage> mDecodedImages;
+
+    // Main thread bookkeeping
+    std::unordered_set<std::string> mRequestedPaths;
+    std::unordered_set<std::string> mFailedPaths;
+    std::size_t mRequestedCount;
+    std::size_t mFinishedCount;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "bitmap_text.h"
+#include <algorithm>
+
+BitmapText::BitmapText() : mAtlas(nullptr), mCharacterSize(30), mFillColor(sf::Color::White), mLayoutDirty(true) {}
+
+void BitmapText::setAtlas(const GlyphAtlas& atlas)
+{
+    if (mAtlas != &atlas)
+    {
+        mAtlas = &atlas;
+        mLayoutDirty = true;
+    }
+}
+
+void BitmapText::setString(const std::string& string)
+{
+    if (mString != string)
+    {
+        mString = string;
+        mLayoutDirty = true;
+    }
+}
+
+void BitmapText::setCharacterSize(unsigned int characterSize)
+{
+    if (mCharacterSize != characterSize)
+    {
+        mCharacterSize = characterSize;
+        mLayoutDirty = true;
+    }
+}
+
+sf::FloatRect BitmapText::getLocalBounds() const
+{
+    updateLayout();
+    return mBounds;
+}
+
+sf::FloatRect BitmapText::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+void BitmapText::appendTo(sf::VertexArray& vertices) const
+{
+    updateLayout();
+
+    const sf::Transform& transform = getTransform();
+    for (const sf::Vertex& vertex : mLayout)
+    {
+        vertices.append(sf::Vertex(transform.transformPoint(vertex.position), mFillColor, vertex.texCoords));
+    }
+}
+
+void BitmapText::updateLayout() const
+{
+    if (!mLayoutDirty)
+    {
+        return;
+    }
+    mLayoutDirty = false;
+    mLayout.clear();
+    mBounds = sf::FloatRect();
+
+    if (!mAtlas)
+    {
+        return;
+    }
+
+    // Same baseline and line handling as sf::Text, without kerning or styles
+    const float padding = static_cast<float>(GlyphAtlas::GLYPH_PADDING);
+    const sf::Glyph* space = mAtlas->getGlyph(' ', mCharacterSize);
+    float spaceAdvance = space ? space->advance : mCharacterSize * 0.3f;
+    float lineSpacing = mAtlas->getLineSpacing(mCharacterSize);
+
+    float x = 0.f;
+    float y = static_cast<float>(mCharacterSize);
+    float minX = static_cast<float>(mCharacterSize);
+    float minY = static_cast<float>(mCharacterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+
+    for (char character : mString)
+    {
+        if (character == '\n' || character == ' ' || character == '\t')
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            if (character == '\n')
+            {
+                y += lineSpacing;
+                x = 0.f;
+            }
+            else
+            {
+                x += character == ' ' ? spaceAdvance : spaceAdvance * 4;
+            }
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        const sf::Glyph* glyph = mAtlas->getGlyph(character, mCharacterSize);
+        if (!glyph)
+        {
+            continue;
+        }
+
+        float left = x + glyph->bounds.left - padding;
+        float top = y + glyph->bounds.top - padding;
+        float right = x + glyph->bounds.left + glyph->bounds.width + padding;
+        float bottom = y + glyph->bounds.top + glyph->bounds.height + padding;
+
+        float u1 = static_cast<float>(glyph->textureRect.left) - padding;
+        float v1 = static_cast<float>(glyph->textureRect.top) - padding;
+        float u2 = static_cast<float>(glyph->textureRect.left + glyph->textureRect.width) + padding;
+        float v2 = static_cast<float>(glyph->textureRect.top + glyph->textureRect.height) + padding;
+
+        mLayout.push_back(sf::Vertex(sf::Vector2f(left, top), sf::Color::White, sf::Vector2f(u1, v1)));
+        mLayout.push_back(sf::Vertex(sf::Vector2f(right, top), sf::Color::White, sf::Vector2f(u2, v1)));
+        mLayout.push_back(sf::Vertex(sf::Vector2f(left, bottom), sf::Color::White, sf::Vector2f(u1, v2)));
+        mLayout.push_back(sf::Vertex(sf::Vector2f(left, bottom), sf::Color::White, sf::Vector2f(u1, v2)));
+        mLayout.push_back(sf::Vertex(sf::Vector2f(right, top), sf::Color::White, sf::Vector2f(u2, v1)));
+        mLayout.push_back(sf::Vertex(sf::Vector2f(right, bottom), sf::Color::White, sf::Vector2f(u2, v2)));
+
+        minX = std::min(minX, x + glyph->bounds.left);
+        maxX = std::max(maxX, x + glyph->bounds.left + glyph->bounds.width);
+        minY = std::min(minY, y + glyph->bounds.top);
+        maxY = std::max(maxY, y + glyph->bounds.top + glyph->bounds.height);
+
+        x += glyph->advance;
+    }
+
+    if (maxX >= minX && maxY >= minY)
+    {
+        mBounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
+}
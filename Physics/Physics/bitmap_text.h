@@ -0,0 +1,46 @@
+#ifndef BITMAP_TEXT_H
+#define BITMAP_TEXT_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "glyph_atlas.h"
+
+// Text laid out from a GlyphAtlas. Stands in for sf::Text, but is not drawn by itself:
+// it is added to a TextBatch, which draws all of its text with a single draw call.
+// The glyph layout is cached and only rebuilt when the string or size changes.
+class BitmapText : public sf::Transformable
+{
+public:
+    BitmapText();
+
+    void setAtlas(const GlyphAtlas& atlas);
+    void setString(const std::string& string);
+    void setCharacterSize(unsigned int characterSize);
+    void setFillColor(const sf::Color& color) { mFillColor = color; }
+
+    const GlyphAtlas* getAtlas() const { return mAtlas; }
+    const std::string& getString() const { return mString; }
+    const sf::Color& getFillColor() const { return mFillColor; }
+
+    sf::FloatRect getLocalBounds() const;
+    sf::FloatRect getGlobalBounds() const;
+
+    // Appends transformed, coloured triangles for every glyph
+    void appendTo(sf::VertexArray& vertices) const;
+
+private:
+    void updateLayout() const;
+
+    const GlyphAtlas* mAtlas;
+    std::string mString;
+    unsigned int mCharacterSize;
+    sf::Color mFillColor;
+
+    // Layout in local coordinates
+    mutable std::vector<sf::Vertex> mLayout;
+    mutable sf::FloatRect mBounds;
+    mutable bool mLayoutDirty;
+};
+
+#endif
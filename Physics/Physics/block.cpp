@@ -5,7 +5,7 @@
 const float Block::MAX_HEALTH = 100.f;
 
 Block::Block(const sf::Texture& texture, float width, float height)
-    : mHealth(MAX_HEALTH)
+    : mHealth(MAX_HEALTH), mImpactPoint(0.f, 0.f), mHasImpactPoint(false)
 {
     setTexture(texture);
     setSize(width, height);
@@ -21,18 +21,14 @@ Block::Block(const sf::Texture& texture, float width, float height)
 
 void Block::update(sf::Time deltaTime) 
 {
-    if (mPhysicsBody) {
-        b2Vec2 position = mPhysicsBody->GetPosition();
-        float angle = mPhysicsBody->GetAngle();
-        setPosition(position.x * PhysicsWorld::SCALE, position.y * PhysicsWorld::SCALE);
-        setRotation(angle * 180.f / b2_pi);
-    }
+    // Only the sprite follows the body, writing the transform back would move the body
+    GameObject::update(deltaTime);
 }
 
 
-void Block::render(sf::RenderWindow& window)
+void Block::render(RenderSnapshot& snapshot)
 {
-    window.draw(mSprite);
+    snapshot.draw(mSprite);
 }
 
 void Block::onCollision(GameObject* other)
@@ -41,7 +37,15 @@ void Block::onCollision(GameObject* other)
     if (projectile)
     {
         float damageAmount = projectile->calculateDamage();
-        this->damage(damageAmount);
+        b2Body* projectileBody = projectile->getPhysicsBody();
+        if (projectileBody)
+        {
+            this->damage(damageAmount, projectileBody->GetPosition());
+        }
+        else
+        {
+            this->damage(damageAmount);
+        }
     }
 }
 
@@ -55,6 +59,22 @@ void Block::damage(float amount)
     }
 }
 
+void Block::damage(float amount, const b2Vec2& impactPoint)
+{
+    mImpactPoint = impactPoint;
+    mHasImpactPoint = true;
+    damage(amount);
+}
+
+b2Vec2 Block::getImpactPoint() const
+{
+    if (mHasImpactPoint || !mPhysicsBody)
+    {
+        return mImpactPoint;
+    }
+    return mPhysicsBody->GetWorldCenter();
+}
+
 bool Block::isDestroyed() const
 {
     return mHealth <= 0;
@@ -80,6 +100,7 @@ void Block::initPhysicsBody(PhysicsWorld& world, bool isStatic)
     fixtureDef.density = isStatic ? 0.0f : 0.8f;
     fixtureDef.friction = 0.5f;
     fixtureDef.restitution = 0.2f;
+    fixtureDef.filter = getCollisionFilter();
 
     mPhysicsBody->CreateFixture(&fixtureDef);
 }
@@ -10,16 +10,23 @@ public:
     Block(const sf::Texture& texture, float width, float height);
 
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow& window) override;
+    void render(RenderSnapshot& snapshot) override;
     void onCollision(GameObject* other) override;
+    Kind getKind() const override { return Kind::Block; }
 
     void damage(float amount);
+    void damage(float amount, const b2Vec2& impactPoint);
     bool isDestroyed() const;
     float getHealth() const { return mHealth; }
     void initPhysicsBody(PhysicsWorld& world, bool isStatic = false);
 
+    // Where the last damage came from in world metres, the body centre if never hit there
+    b2Vec2 getImpactPoint() const;
+
 private:
     float mHealth;
+    b2Vec2 mImpactPoint;
+    bool mHasImpactPoint;
     static const float MAX_HEALTH;
 };
 
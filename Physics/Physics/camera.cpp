@@ -0,0 +1,156 @@
+#include "camera.h"
+#include "physics_world.h"
+#include <algorithm>
+#include <cmath>
+
+Camera::Camera() : mBaseSize(0.f, 0.f), mZoom(1.f), mHasBounds(false), mIsFollowing(false), mIsPanning(false) {}
+
+void Camera::initialize(const sf::Vector2f& viewSize)
+{
+    mBaseSize = viewSize;
+    mZoom = 1.f;
+    mView.setSize(viewSize);
+    mView.setCenter(viewSize / 2.f);
+    mIsFollowing = false;
+    clampToBounds();
+}
+
+void Camera::handleEvent(const sf::Event& event, const sf::RenderWindow& window)
+{
+    if (event.type == sf::Event::Resized)
+    {
+        // The view grows with the window instead of stretching, the world itself is unchanged
+        mBaseSize = sf::Vector2f(static_cast<float>(event.size.width), static_cast<float>(event.size.height));
+        applyZoom();
+    }
+
+    if (event.type == sf::Event::MouseWheelScrolled)
+    {
+        // Scrolling up zooms in
+        zoom(event.mouseWheelScroll.delta > 0 ? 1.f / ZOOM_STEP : ZOOM_STEP);
+    }
+
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right)
+    {
+        mIsPanning = true;
+        mLastMousePosition = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+    }
+
+    if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Right)
+    {
+        mIsPanning = false;
+    }
+
+    if (event.type == sf::Event::MouseMoved && mIsPanning)
+    {
+        sf::Vector2i mousePosition(event.mouseMove.x, event.mouseMove.y);
+        sf::Vector2f previous = window.mapPixelToCoords(mLastMousePosition, mView);
+        sf::Vector2f current = window.mapPixelToCoords(mousePosition, mView);
+        pan(previous - current);
+        mLastMousePosition = mousePosition;
+    }
+}
+
+void Camera::update(sf::Time deltaTime)
+{
+    sf::Vector2f direction(0.f, 0.f);
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))  direction.x -= 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) direction.x += 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))    direction.y -= 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))  direction.y += 1.f;
+
+    if (direction.x != 0.f || direction.y != 0.f)
+    {
+        pan(direction * PAN_SPEED * mZoom * deltaTime.asSeconds());
+    }
+
+    if (mIsFollowing)
+    {
+        sf::Vector2f center = mView.getCenter();
+        sf::Vector2f offset = mFollowTarget - center;
+        float t = std::min(1.f, FOLLOW_SPEED * deltaTime.asSeconds());
+        mView.setCenter(center + offset * t);
+        clampToBounds();
+
+        // Stop once the target is reached or the bounds keep the view from getting closer
+        sf::Vector2f remaining = mFollowTarget - mView.getCenter();
+        if ((std::abs(remaining.x) < 1.f && std::abs(remaining.y) < 1.f) ||
+            mView.getCenter() == center)
+        {
+            mIsFollowing = false;
+        }
+    }
+}
+
+void Camera::pan(const sf::Vector2f& offset)
+{
+    mIsFollowing = false;
+    mView.move(offset);
+    clampToBounds();
+}
+
+void Camera::zoom(float factor)
+{
+    mZoom = std::max(MIN_ZOOM, std::min(mZoom * factor, MAX_ZOOM));
+    applyZoom();
+}
+
+void Camera::setCenter(const sf::Vector2f& center)
+{
+    mView.setCenter(center);
+    clampToBounds();
+}
+
+void Camera::follow(const sf::Vector2f& target)
+{
+    mFollowTarget = target;
+    mIsFollowing = true;
+}
+
+void Camera::setBounds(const sf::FloatRect& bounds)
+{
+    mBounds = bounds;
+    mHasBounds = true;
+    clampToBounds();
+}
+
+b2AABB Camera::getVisibleAABB() const
+{
+    sf::Vector2f halfSize = mView.getSize() / 2.f;
+    sf::Vector2f center = mView.getCenter();
+
+    b2AABB aabb;
+    aabb.lowerBound.Set((center.x - halfSize.x) * PhysicsWorld::INVERSE_SCALE, (center.y - halfSize.y) * PhysicsWorld::INVERSE_SCALE);
+    aabb.upperBound.Set((center.x + halfSize.x) * PhysicsWorld::INVERSE_SCALE, (center.y + halfSize.y) * PhysicsWorld::INVERSE_SCALE);
+    return aabb;
+}
+
+void Camera::applyZoom()
+{
+    mView.setSize(mBaseSize * mZoom);
+    clampToBounds();
+}
+
+void Camera::clampToBounds()
+{
+    if (!mHasBounds)
+    {
+        return;
+    }
+
+    sf::Vector2f halfSize = mView.getSize() / 2.f;
+    sf::Vector2f center = mView.getCenter();
+
+    // If the view is larger than the bounds on an axis, centre it on that axis instead
+    if (mView.getSize().x >= mBounds.width)
+        center.x = mBounds.left + mBounds.width / 2.f;
+    else
+        center.x = std::max(mBounds.left + halfSize.x, std::min(center.x, mBounds.left + mBounds.width - halfSize.x));
+
+    if (mView.getSize().y >= mBounds.height)
+        center.y = mBounds.top + mBounds.height / 2.f;
+    else
+        center.y = std::max(mBounds.top + halfSize.y, std::min(center.y, mBounds.top + mBounds.height - halfSize.y));
+
+    mView.setCenter(center);
+}
@@ -0,0 +1,55 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+
+class Camera
+{
+public:
+    Camera();
+
+    void initialize(const sf::Vector2f& viewSize);
+    void handleEvent(const sf::Event& event, const sf::RenderWindow& window);
+    void update(sf::Time deltaTime);
+
+    void pan(const sf::Vector2f& offset);
+    void zoom(float factor);
+    void setCenter(const sf::Vector2f& center);
+
+    // Eases the view towards a target until it is reached or the player pans manually
+    void follow(const sf::Vector2f& target);
+
+    // Area in pixels the view is kept inside of
+    void setBounds(const sf::FloatRect& bounds);
+
+    const sf::View& getView() const { return mView; }
+
+    // Visible rectangle in Box2D metres, used for broadphase culling
+    b2AABB getVisibleAABB() const;
+
+private:
+    void applyZoom();
+    void clampToBounds();
+
+    sf::View mView;
+    sf::Vector2f mBaseSize;
+    float mZoom;
+
+    sf::FloatRect mBounds;
+    bool mHasBounds;
+
+    sf::Vector2f mFollowTarget;
+    bool mIsFollowing;
+
+    bool mIsPanning;
+    sf::Vector2i mLastMousePosition;
+
+    const float PAN_SPEED = 800.f; // Pixels per second at zoom 1
+    const float ZOOM_STEP = 1.1f;
+    const float MIN_ZOOM = 0.5f;
+    const float MAX_ZOOM = 3.0f;
+    const float FOLLOW_SPEED = 5.f; // Fraction of the remaining distance covered per second
+};
+
+#endif
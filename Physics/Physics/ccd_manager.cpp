@@ -0,0 +1,78 @@
+#include "ccd_manager.h"
+#include <algorithm>
+
+namespace
+{
+    // Projectiles are what hits things hard, so they turn into bullets early. Debris is
+    // small and plentiful and may pass through other dynamic bodies, but not the level.
+    const CcdManager::Policy PROJECTILE_POLICY = { true, 0.1f, 0.05f };
+    const CcdManager::Policy BLOCK_POLICY = { true, 0.5f, 0.3f };
+    const CcdManager::Policy DEBRIS_POLICY = { false, 0.f, 0.f };
+}
+
+const CcdManager::Policy& CcdManager::getPolicy(GameObject::Kind kind)
+{
+    switch (kind)
+    {
+    case GameObject::Kind::Projectile:
+        return PROJECTILE_POLICY;
+    case GameObject::Kind::Debris:
+        return DEBRIS_POLICY;
+    case GameObject::Kind::Block:
+    case GameObject::Kind::Enemy:
+    default:
+        return BLOCK_POLICY;
+    }
+}
+
+void CcdManager::update(b2Body* body, GameObject::Kind kind, float timeStep) const
+{
+    const Policy& policy = getPolicy(kind);
+    if (!policy.allowBullet)
+    {
+        if (body->IsBullet())
+        {
+            body->SetBullet(false);
+        }
+        return;
+    }
+
+    float thickness = getThickness(body);
+    if (thickness <= 0.f)
+    {
+        return;
+    }
+
+    float ratio = body->GetLinearVelocity().Length() * timeStep / thickness;
+    if (!body->IsBullet() && ratio > policy.enableRatio)
+    {
+        body->SetBullet(true);
+    }
+    else if (body->IsBullet() && ratio < policy.disableRatio)
+    {
+        body->SetBullet(false);
+    }
+}
+
+float CcdManager::getThickness(const b2Body* body)
+{
+    b2Transform identity;
+    identity.SetIdentity();
+
+    float thickness = 0.f;
+    bool first = true;
+    for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+    {
+        const b2Shape* shape = fixture->GetShape();
+        for (int child = 0; child < shape->GetChildCount(); ++child)
+        {
+            b2AABB aabb;
+            shape->ComputeAABB(&aabb, identity, child);
+            b2Vec2 extents = aabb.upperBound - aabb.lowerBound;
+            float size = std::min(extents.x, extents.y);
+            thickness = first ? size : std::min(thickness, size);
+            first = false;
+        }
+    }
+    return thickness;
+}
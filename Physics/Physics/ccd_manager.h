@@ -0,0 +1,30 @@
+#ifndef CCD_MANAGER_H
+#define CCD_MANAGER_H
+
+#include <box2d/box2d.h>
+#include "game_object.h"
+
+// Decides per body whether Box2D should treat it as a bullet, which makes it sweep against
+// other dynamic bodies in solveTOI. Only a body that moves a large part of its own thickness
+// in one step can tunnel, so the flag follows speed relative to size, with a lower threshold
+// to turn it off again so it does not flicker. Static geometry is always swept against.
+class CcdManager
+{
+public:
+    struct Policy
+    {
+        bool allowBullet;
+        float enableRatio;  // Step translation over thickness above which the body becomes a bullet
+        float disableRatio; // and below which it stops being one
+    };
+
+    static const Policy& getPolicy(GameObject::Kind kind);
+
+    // Called for awake dynamic bodies right before a step
+    void update(b2Body* body, GameObject::Kind kind, float timeStep) const;
+
+    // Smallest extent of the body's fixtures, the distance it can cover without tunnelling
+    static float getThickness(const b2Body* body);
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "collision_filter.h"
+
+b2Filter CollisionFilter::make(uint16 category, uint16 mask)
+{
+    b2Filter filter;
+    filter.categoryBits = category;
+    filter.maskBits = mask;
+    return filter;
+}
+
+b2Filter CollisionFilter::forKind(GameObject::Kind kind)
+{
+    switch (kind)
+    {
+    case GameObject::Kind::Block:
+        return make(BLOCK, GROUND | BLOCK | ENEMY | PROJECTILE | DEBRIS | OTHER);
+    case GameObject::Kind::Enemy:
+        return make(ENEMY, GROUND | BLOCK | ENEMY | PROJECTILE | DEBRIS | OTHER);
+    case GameObject::Kind::Projectile:
+        // Split siblings leave from the same point and would only push each other apart
+        return make(PROJECTILE, GROUND | BLOCK | ENEMY | OTHER);
+    case GameObject::Kind::Debris:
+        // Fragments settle on the structure but neither stack on each other nor stop shots
+        return make(DEBRIS, GROUND | BLOCK | ENEMY);
+    case GameObject::Kind::Other:
+    default:
+        return make(OTHER, 0xFFFF);
+    }
+}
+
+b2Filter CollisionFilter::forGround()
+{
+    return make(GROUND, 0xFFFF);
+}
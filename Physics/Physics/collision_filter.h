@@ -0,0 +1,27 @@
+#ifndef COLLISION_FILTER_H
+#define COLLISION_FILTER_H
+
+#include <box2d/box2d.h>
+#include "game_object.h"
+
+// Category and mask bits for every kind of fixture in a level. Box2D only lets a pair
+// into the narrow phase, and on to BeginContact, when each side's mask has the other's
+// category, so pairs the game never reacts to cost nothing past the broadphase.
+class CollisionFilter
+{
+public:
+    static const uint16 GROUND = 0x0001;
+    static const uint16 BLOCK = 0x0002;
+    static const uint16 ENEMY = 0x0004;
+    static const uint16 PROJECTILE = 0x0008;
+    static const uint16 DEBRIS = 0x0010;
+    static const uint16 OTHER = 0x8000;
+
+    static b2Filter forKind(GameObject::Kind kind);
+    static b2Filter forGround();
+
+private:
+    static b2Filter make(uint16 category, uint16 mask);
+};
+
+#endif
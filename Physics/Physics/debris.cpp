@@ -0,0 +1,36 @@
+#include "debris.h"
+#include "physics_world.h"
+
+Debris::Debris() : mIsActive(false), mLifetime(sf::Time::Zero)
+{
+    mShape.setPointCount(3);
+}
+
+void Debris::update(sf::Time deltaTime)
+{
+    GameObject::update(deltaTime);
+}
+
+void Debris::render(RenderSnapshot& snapshot)
+{
+    // The sprite carries the synced or interpolated transform, the shape is what is drawn
+    mShape.setPosition(mSprite.getPosition());
+    mShape.setRotation(mSprite.getRotation());
+    snapshot.draw(mShape);
+}
+
+void Debris::setFragment(const b2Vec2* vertices, int count, const sf::Texture* texture, const sf::IntRect& textureRect)
+{
+    if (static_cast<int>(mShape.getPointCount()) != count)
+    {
+        mShape.setPointCount(count);
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        mShape.setPoint(i, sf::Vector2f(vertices[i].x * PhysicsWorld::SCALE, vertices[i].y * PhysicsWorld::SCALE));
+    }
+
+    mShape.setTexture(texture);
+    mShape.setTextureRect(textureRect);
+    mShape.setFillColor(sf::Color::White);
+}
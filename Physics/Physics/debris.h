@@ -0,0 +1,33 @@
+#ifndef DEBRIS_H
+#define DEBRIS_H
+
+#include "game_object.h"
+#include <SFML/Graphics.hpp>
+
+// One fragment of a fractured block. Debris objects and their bodies belong to a DebrisPool
+// and are reused, so activating one only reshapes and enables a body that already exists.
+class Debris : public GameObject
+{
+public:
+    Debris();
+
+    void update(sf::Time deltaTime) override;
+    void render(RenderSnapshot& snapshot) override;
+    void onCollision(GameObject* other) override {}
+    Kind getKind() const override { return Kind::Debris; }
+
+    // Local polygon in metres around the body origin and where it sits on the texture
+    void setFragment(const b2Vec2* vertices, int count, const sf::Texture* texture, const sf::IntRect& textureRect);
+
+    bool isActive() const { return mIsActive; }
+    void setActive(bool active) { mIsActive = active; }
+    sf::Time getLifetime() const { return mLifetime; }
+    void setLifetime(sf::Time lifetime) { mLifetime = lifetime; }
+
+private:
+    sf::ConvexShape mShape;
+    bool mIsActive;
+    sf::Time mLifetime;
+};
+
+#endif
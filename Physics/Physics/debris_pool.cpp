@@ -0,0 +1,226 @@
+#include "debris_pool.h"
+#include "physics_world.h"
+#include "collision_filter.h"
+#include <algorithm>
+
+const int DebrisPool::POOL_SIZE = 8 * DebrisPool::FRAGMENTS_PER_BLOCK; // Eight blocks breaking at once
+const sf::Time DebrisPool::FRAGMENT_LIFETIME = sf::seconds(4.f);
+const float DebrisPool::BURST_SPEED = 2.f; // Metres per second away from the impact
+
+namespace
+{
+    const b2Vec2 PARKING_POSITION(-100.f, -100.f); // Outside any level
+}
+
+DebrisPool::DebrisPool() : mNext(0), mWorld(nullptr), mTexture(nullptr) {}
+
+const std::vector<DebrisPool::Pattern>& DebrisPool::getPatterns()
+{
+    // Triangles fanning out from a focus to the corners and edge midpoints of the unit
+    // square, for a grid of foci so the break can start near where the block was hit
+    static std::vector<Pattern> patterns;
+    if (patterns.empty())
+    {
+        const b2Vec2 ring[FRAGMENTS_PER_BLOCK] =
+        {
+            b2Vec2(0.f, 0.f), b2Vec2(0.5f, 0.f), b2Vec2(1.f, 0.f), b2Vec2(1.f, 0.5f),
+            b2Vec2(1.f, 1.f), b2Vec2(0.5f, 1.f), b2Vec2(0.f, 1.f), b2Vec2(0.f, 0.5f)
+        };
+        const float foci[] = { 0.25f, 0.5f, 0.75f };
+
+        for (float y : foci)
+        {
+            for (float x : foci)
+            {
+                Pattern pattern;
+                pattern.focus.Set(x, y);
+                for (int i = 0; i < FRAGMENTS_PER_BLOCK; ++i)
+                {
+                    pattern.fragments[i] = { pattern.focus, ring[i], ring[(i + 1) % FRAGMENTS_PER_BLOCK] };
+                }
+                patterns.push_back(pattern);
+            }
+        }
+    }
+    return patterns;
+}
+
+const DebrisPool::Pattern& DebrisPool::findPattern(const b2Vec2& unitImpact)
+{
+    const std::vector<Pattern>& patterns = getPatterns();
+    const Pattern* best = &patterns.front();
+    float bestDistance = b2DistanceSquared(unitImpact, best->focus);
+    for (const Pattern& pattern : patterns)
+    {
+        float distance = b2DistanceSquared(unitImpact, pattern.focus);
+        if (distance < bestDistance)
+        {
+            best = &pattern;
+            bestDistance = distance;
+        }
+    }
+    return *best;
+}
+
+void DebrisPool::initialize(PhysicsWorld& world, const sf::Texture* texture)
+{
+    mWorld = &world;
+    mTexture = texture;
+    mNext = 0;
+    getPatterns();
+
+    if (mDebris.empty())
+    {
+        mDebris.reserve(POOL_SIZE);
+        for (int i = 0; i < POOL_SIZE; ++i)
+        {
+            mDebris.push_back(std::make_unique<Debris>());
+        }
+    }
+
+    // Any triangle will do until a fragment is first used
+    b2PolygonShape shape;
+    const auto& placeholder = getPatterns().front().fragments.front();
+    shape.Set(placeholder.data(), 3);
+
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &shape;
+    fixtureDef.density = 0.8f;
+    fixtureDef.friction = 0.5f;
+    fixtureDef.restitution = 0.1f;
+    fixtureDef.filter = CollisionFilter::forKind(GameObject::Kind::Debris);
+
+    for (const auto& debris : mDebris)
+    {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = PARKING_POSITION;
+        bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(debris.get());
+
+        // Created enabled and then parked, so the broadphase tree has grown to hold every
+        // fragment before the first collapse needs it
+        b2Body* body = world.createBody(bodyDef);
+        body->CreateFixture(&fixtureDef);
+        debris->setPhysicsBody(body);
+        deactivate(*debris);
+    }
+}
+
+void DebrisPool::release()
+{
+    for (const auto& debris : mDebris)
+    {
+        debris->setPhysicsBody(nullptr);
+        debris->setActive(false);
+    }
+    mWorld = nullptr;
+}
+
+void DebrisPool::deactivate(Debris& debris)
+{
+    b2Body* body = debris.getPhysicsBody();
+    if (body)
+    {
+        // Takes it out of the awake set and wakes whatever it was resting on
+        mWorld->setBodyEnabled(body, false);
+    }
+    debris.setActive(false);
+}
+
+void DebrisPool::fracture(const b2Body& block, const b2Vec2& impactPoint)
+{
+    if (mDebris.empty() || !block.GetFixtureList())
+    {
+        return;
+    }
+
+    // Block extents in its own frame
+    b2Transform identity;
+    identity.SetIdentity();
+    b2AABB bounds;
+    block.GetFixtureList()->GetShape()->ComputeAABB(&bounds, identity, 0);
+    b2Vec2 size = bounds.upperBound - bounds.lowerBound;
+    if (size.x <= 0.f || size.y <= 0.f)
+    {
+        return;
+    }
+
+    b2Vec2 localImpact = block.GetLocalPoint(impactPoint) - bounds.lowerBound;
+    b2Vec2 unitImpact(b2Clamp(localImpact.x / size.x, 0.f, 1.f), b2Clamp(localImpact.y / size.y, 0.f, 1.f));
+    const Pattern& pattern = findPattern(unitImpact);
+
+    sf::Vector2u textureSize = mTexture ? mTexture->getSize() : sf::Vector2u(0, 0);
+
+    for (const auto& unitTriangle : pattern.fragments)
+    {
+        Debris& debris = *mDebris[mNext];
+        mNext = (mNext + 1) % mDebris.size();
+
+        b2Body* body = debris.getPhysicsBody();
+        if (!body)
+        {
+            continue;
+        }
+        if (debris.isActive())
+        {
+            deactivate(debris);
+        }
+
+        b2Vec2 vertices[3];
+        b2Vec2 unitMin = unitTriangle[0];
+        b2Vec2 unitMax = unitTriangle[0];
+        for (int i = 0; i < 3; ++i)
+        {
+            vertices[i].Set(bounds.lowerBound.x + unitTriangle[i].x * size.x, bounds.lowerBound.y + unitTriangle[i].y * size.y);
+            unitMin = b2Min(unitMin, unitTriangle[i]);
+            unitMax = b2Max(unitMax, unitTriangle[i]);
+        }
+
+        // Reshaped while disabled, so there is no proxy to refresh
+        static_cast<b2PolygonShape*>(body->GetFixtureList()->GetShape())->Set(vertices, 3);
+        body->ResetMassData();
+        body->SetTransform(block.GetPosition(), block.GetAngle());
+        mWorld->setBodyEnabled(body, true);
+
+        // Carry on moving with the block, plus a push away from the impact
+        b2Vec2 center = body->GetWorldCenter();
+        b2Vec2 away = center - impactPoint;
+        if (away.Normalize() < b2_epsilon)
+        {
+            away.SetZero();
+        }
+        body->SetLinearVelocity(block.GetLinearVelocityFromWorldPoint(center) + BURST_SPEED * away);
+        body->SetAngularVelocity(block.GetAngularVelocity());
+        mWorld->wakeBody(body);
+
+        sf::IntRect textureRect(static_cast<int>(unitMin.x * textureSize.x), static_cast<int>(unitMin.y * textureSize.y),
+            static_cast<int>((unitMax.x - unitMin.x) * textureSize.x), static_cast<int>((unitMax.y - unitMin.y) * textureSize.y));
+        debris.setFragment(vertices, 3, mTexture, textureRect);
+        debris.resetInterpolation();
+        debris.update(sf::Time::Zero);
+        debris.setLifetime(FRAGMENT_LIFETIME);
+        debris.setActive(true);
+    }
+}
+
+void DebrisPool::update(sf::Time deltaTime)
+{
+    for (const auto& debris : mDebris)
+    {
+        if (!debris->isActive())
+        {
+            continue;
+        }
+
+        if (debris->needsUpdate())
+        {
+            debris->update(deltaTime);
+        }
+
+        debris->setLifetime(debris->getLifetime() - deltaTime);
+        if (debris->getLifetime() <= sf::Time::Zero)
+        {
+            deactivate(*debris);
+        }
+    }
+}
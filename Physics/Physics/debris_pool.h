@@ -0,0 +1,57 @@
+#ifndef DEBRIS_POOL_H
+#define DEBRIS_POOL_H
+
+#include <box2d/box2d.h>
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+#include "debris.h"
+
+class PhysicsWorld;
+
+// Breaks destroyed blocks into convex fragments. Every fragment body, fixture and shape is
+// created when the level is set up and parked disabled; fracturing a block reshapes the
+// next free fragments to one of a few precomputed patterns and enables them, so a large
+// collapse does not allocate. When every fragment is in use the oldest is taken back.
+class DebrisPool
+{
+public:
+    DebrisPool();
+
+    // Creates the fragment bodies in the world, called again after the world was replaced
+    void initialize(PhysicsWorld& world, const sf::Texture* texture);
+
+    // The world is about to be destroyed along with every fragment body
+    void release();
+
+    // Replaces a block body with fragments radiating from the impact point, in world metres
+    void fracture(const b2Body& block, const b2Vec2& impactPoint);
+
+    // Syncs awake fragments and returns expired ones to the pool
+    void update(sf::Time deltaTime);
+
+    static const int POOL_SIZE;
+    static const int FRAGMENTS_PER_BLOCK = 8;
+
+private:
+    struct Pattern
+    {
+        b2Vec2 focus;                                            // Unit square coordinates
+        std::array<std::array<b2Vec2, 3>, FRAGMENTS_PER_BLOCK> fragments;
+    };
+
+    static const std::vector<Pattern>& getPatterns();
+    static const Pattern& findPattern(const b2Vec2& unitImpact);
+    void deactivate(Debris& debris);
+
+    std::vector<std::unique_ptr<Debris>> mDebris;
+    std::size_t mNext; // Ring position, the oldest fragment when the pool is full
+    PhysicsWorld* mWorld;
+    const sf::Texture* mTexture;
+
+    static const sf::Time FRAGMENT_LIFETIME;
+    static const float BURST_SPEED;
+};
+
+#endif
@@ -24,13 +24,13 @@ void Enemy::update(sf::Time deltaTime)
     if (mPhysicsBody)
     {
         b2Vec2 position = mPhysicsBody->GetPosition();
-        setPosition(position.x * PhysicsWorld::SCALE, position.y * PhysicsWorld::SCALE);
+        mSprite.setPosition(position.x * PhysicsWorld::SCALE, position.y * PhysicsWorld::SCALE);
     }
 }
 
-void Enemy::render(sf::RenderWindow& window)
+void Enemy::render(RenderSnapshot& snapshot)
 {
-    window.draw(mSprite);
+    snapshot.draw(mSprite);
 }
 
 void Enemy::onCollision(GameObject* other)
@@ -79,6 +79,7 @@ void Enemy::initPhysicsBody(PhysicsWorld& world)
     fixtureDef.density = 0.9f;
     fixtureDef.friction = 0.3f;
     fixtureDef.restitution = 0.15f;
+    fixtureDef.filter = getCollisionFilter();
 
     mPhysicsBody->CreateFixture(&fixtureDef);
 }
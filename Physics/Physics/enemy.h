@@ -10,8 +10,9 @@ public:
     Enemy(const sf::Texture& texture, float width, float height);
 
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow& window) override;
+    void render(RenderSnapshot& snapshot) override;
     void onCollision(GameObject* other) override;
+    Kind getKind() const override { return Kind::Enemy; }
 
     void damage(float amount);
     bool isDefeated() const;
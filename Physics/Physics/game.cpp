@@ -1,9 +1,27 @@
 #include "Game.h"
 #include "main_menu.h"
+#include "startup_profiler.h"
+#include "asset_cache.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <thread>
 
 const sf::Time Game::TimePerFrame = sf::seconds(1.f / 60.f);
+const int Game::MaxUpdatesPerFrame = 5;
+const std::size_t Game::TextureUploadsPerUpdate = 2; // Keeps each GPU upload batch well inside a frame
+const int Game::LastLevel = 3;
+const int Game::FastForwardSpeeds[] = { 1, 2, 4, 8, 0 };
+const int Game::FastForwardSpeedCount = sizeof(FastForwardSpeeds) / sizeof(FastForwardSpeeds[0]);
+const sf::Time Game::FastForwardBudget = sf::milliseconds(12); // Leaves time in the frame to poll events and publish
+const float Game::SlowMotionScales[] = { 1.f, 0.5f, 0.25f, 0.1f };
+const int Game::SlowMotionScaleCount = sizeof(SlowMotionScales) / sizeof(SlowMotionScales[0]);
 
-Game::Game() : mWindow(nullptr), mGameState(GameState::MainMenu) {}
+Game::Game() : mNeedsRedraw(true), mWindow(nullptr), mCurrentMenu(nullptr), mGameState(GameState::MainMenu),
+mStateAfterLoading(GameState::MainMenu), mFastForwardIndex(0), mSlowMotionIndex(0), mCurrentScene(nullptr),
+mCurrentLevelNumber(1), mNextLevelNumber(0), mIsQuitting(false) {}
 
 Game::~Game()
 {
@@ -16,47 +34,144 @@ Game::~Game()
 void Game::setWindow(sf::RenderWindow* window)
 {
     mWindow = window;
-    setState(GameState::MainMenu);
+    mLoadingScreen = std::make_unique<LoadingScreen>(*mWindow);
+
+    // Leave one core for the simulation and one for the render thread
+    unsigned int cores = std::thread::hardware_concurrency();
+    mAssetLoader.start(std::max(1u, std::min(cores > 2 ? cores - 2 : 1u, 4u)));
+
+    // Only what the menus need, the level's textures follow in the background once the
+    // main menu is up
+    if (!beginLoading(Menu::getRequiredTextures(), GameState::MainMenu))
+    {
+        setState(GameState::MainMenu);
+    }
+}
+
+bool Game::beginLoading(const std::vector<std::string>& textures, GameState nextState)
+{
+    bool queued = false;
+    for (const std::string& texture : textures)
+    {
+        queued |= mAssetLoader.requestTexture(texture);
+    }
+
+    if (queued || !mAssetLoader.isIdle())
+    {
+        mStateAfterLoading = nextState;
+        setState(GameState::Loading);
+        return true;
+    }
+    return false;
+}
+
+void Game::preloadLevelAssets()
+{
+    for (const std::string& texture : LevelScene::getRequiredTextures())
+    {
+        mAssetLoader.requestTexture(texture);
+    }
+}
+
+void Game::updateLoading()
+{
+    mAssetLoader.uploadCompleted(TextureUploadsPerUpdate);
+    mLoadingScreen->setProgress(mAssetLoader.getProgress());
+
+    if (!mAssetLoader.isIdle())
+    {
+        return;
+    }
+
+    // A level built behind the loading screen is switched to once the worker is done
+    if (mLevelBuild.valid())
+    {
+        if (mLevelBuild.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return;
+        }
+        mLevelScene = mLevelBuild.get();
+    }
+
+    StartupProfiler::getInstance().markPhase("Load assets");
+    setState(mStateAfterLoading);
 }
 
 void Game::initializeMenus()
 {
-    if (mWindow)
+    // Built once, after the startup loading screen has put their textures in the cache
+    if (mWindow && !mMainMenu)
+    {
+        mMainMenu = std::make_unique<MainMenu>(*mWindow, [this](int option) { handleMainMenuCallback(option); });
+        mPauseMenu = std::make_unique<PauseMenu>(*mWindow, [this](int option) { handlePauseMenuCallback(option); });
+        mLoseScreen = std::make_unique<LoseScreen>(*mWindow, *this);
+        mWinScreen = std::make_unique<WinScreen>(*mWindow, *this);
+        mInstructionsScreen = std::make_unique<InstructionsScreen>(*mWindow, [this]() { handleHowToPlayCallback(); });
+
+        // The main menu is next, so this is the end of startup
+        StartupProfiler::getInstance().markPhase("Build menus");
+        StartupProfiler::getInstance().report();
+    }
+}
+
+void Game::showMenu(Menu* menu)
+{
+    mCurrentMenu = menu;
+    if (mCurrentMenu)
     {
-        mCurrentMenu = std::make_unique<MainMenu>(*mWindow);
+        mCurrentMenu->activate();
     }
 }
 
 void Game::setState(GameState newState)
 {
+    if (newState != GameState::Loading)
+    {
+        initializeMenus();
+    }
+
     mGameState = newState;
+    mNeedsRedraw = true;
     switch (mGameState)
     {
     case GameState::MainMenu:
         resetGameState();
-        mCurrentMenu = std::make_unique<MainMenu>(*mWindow, [this](int option) { handleMainMenuCallback(option); });
+        showMenu(mMainMenu.get());
+        preloadLevelAssets();
         break;
     case GameState::Playing:
-        mCurrentMenu.reset();
-        if (!mLevelScene) {
-            mLevelScene = std::make_unique<LevelScene>();
-            mLevelScene->setWindow(mWindow);
-            mLevelScene->initialize();
+        showMenu(nullptr);
+        if (!mLevelScene)
+        {
+            // Comes back here once the level's textures are on the GPU, and again once the
+            // level has been built behind the loading screen
+            if (!beginLoading(LevelScene::getRequiredTextures(), GameState::Playing))
+            {
+                mLevelBuild = buildLevel(mCurrentLevelNumber);
+                mStateAfterLoading = GameState::Playing;
+                setState(GameState::Loading);
+            }
+            return;
         }
         mCurrentScene = mLevelScene.get();
+        prebuildNextLevel();
         break;
     case GameState::Paused:
-        mCurrentMenu = std::make_unique<PauseMenu>(*mWindow, [this](int option) { handlePauseMenuCallback(option); });
+        showMenu(mPauseMenu.get());
         break;
     case GameState::GameOver:
-        mCurrentMenu = std::make_unique<LoseScreen>(*mWindow, *this);
+        showMenu(mLoseScreen.get());
         break;
     case GameState::GameWon:
-        mCurrentMenu = std::make_unique<WinScreen>(*mWindow, *this);
+        showMenu(mWinScreen.get());
         break;
     case GameState::HowToPlay:
         resetGameState();
-        mCurrentMenu = std::make_unique<InstructionsScreen>(*mWindow, [this]() { handleHowToPlayCallback(); });
+        showMenu(mInstructionsScreen.get());
+        break;
+    case GameState::Loading:
+        mLoadingScreen->setProgress(0.f);
+        showMenu(mLoadingScreen.get());
         break;
     }
 }
@@ -72,10 +187,7 @@ void Game::handleMainMenuCallback(int option)
         setState(GameState::HowToPlay);
         break;
     case 2: // Quit
-        if (mWindow)
-        {
-            mWindow->close();
-        }
+        closeWindow();
         break;
     }
 }
@@ -87,25 +199,65 @@ void Game::run()
         return;
     }
 
+    // Drawing happens on the render thread, this thread polls events and simulates
+    mRenderThread.start(*mWindow);
+    StartupProfiler::getInstance().markPhase("Start render thread");
+
     sf::Clock clock;
     sf::Time timeSinceLastUpdate = sf::Time::Zero;
 
     while (mWindow->isOpen() && !mIsQuitting)
     {
+        if (isIdle())
+        {
+            // Nothing on screen can change until input arrives, and the wait is not simulated time
+            waitForEvent();
+            clock.restart();
+            timeSinceLastUpdate = sf::Time::Zero;
+        }
+
         processEvents();
-        timeSinceLastUpdate += clock.restart();
+        sf::Time elapsed = clock.restart();
+        timeSinceLastUpdate += getScaledTime(elapsed);
 
-        while (timeSinceLastUpdate > TimePerFrame && !mIsQuitting)
+        sf::Clock stepClock;
+        int updates = 0;
+        while (timeSinceLastUpdate >= TimePerFrame && !mIsQuitting)
         {
             timeSinceLastUpdate -= TimePerFrame;
             update(TimePerFrame);
+
+            // Fast-forward steps go back to back and share the one frame rendered after them
+            for (int step = 1; step < getStepsPerUpdate() && mGameState == GameState::Playing && !mIsQuitting
+                && stepClock.getElapsedTime() < FastForwardBudget; ++step)
+            {
+                update(TimePerFrame);
+            }
+
+            // Drop the backlog rather than spiralling when steps cost more than they simulate
+            if (++updates >= MaxUpdatesPerFrame)
+            {
+                timeSinceLastUpdate %= TimePerFrame;
+                break;
+            }
         }
 
-        if (!mIsQuitting)
+        if (!mIsQuitting && mWindow->isOpen())
         {
-            render();
+            updateFrame(elapsed);
+
+            // Never wait on the renderer, but do not spin while it is still busy with the last frame
+            bool rendererBusy = mRenderThread.isSnapshotPending();
+            render(timeSinceLastUpdate / TimePerFrame);
+            mNeedsRedraw = false;
+            if (rendererBusy)
+            {
+                sf::sleep(sf::milliseconds(1));
+            }
         }
     }
+
+    mRenderThread.stop();
 }
 void Game::processEvents()
 {
@@ -113,9 +265,29 @@ void Game::processEvents()
     while (mWindow->pollEvent(event))
     {
         if (event.type == sf::Event::Closed)
-            mWindow->close();
+            closeWindow();
 
         handleEvent(event);
+        mNeedsRedraw = true;
+    }
+}
+
+bool Game::isIdle() const
+{
+    return !mNeedsRedraw && mGameState != GameState::Playing && mCurrentMenu && !mCurrentMenu->isAnimating() &&
+        mAssetLoader.isIdle();
+}
+
+void Game::waitForEvent()
+{
+    sf::Event event;
+    if (mWindow->waitEvent(event))
+    {
+        if (event.type == sf::Event::Closed)
+            closeWindow();
+
+        handleEvent(event);
+        mNeedsRedraw = true;
     }
 }
 
@@ -142,6 +314,15 @@ void Game::handleHowToPlayCallback()
 
 void Game::handleEvent(const sf::Event& event)
 {
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F && mGameState == GameState::Playing)
+    {
+        cycleFastForward();
+    }
+    else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::S && mGameState == GameState::Playing)
+    {
+        cycleSlowMotion();
+    }
+
     if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
     {
         if (mGameState == GameState::Playing)
@@ -161,6 +342,7 @@ void Game::handleEvent(const sf::Event& event)
     case GameState::GameOver:
     case GameState::GameWon:
     case GameState::HowToPlay:
+    case GameState::Loading:
         if (mCurrentMenu)
             mCurrentMenu->handleEvent(event);
         break;
@@ -196,38 +378,75 @@ void Game::update(sf::Time deltaTime)
     case GameState::HowToPlay:
         if (mCurrentMenu)
             mCurrentMenu->update(deltaTime);
+
+        // Textures preloaded behind the menus are uploaded a few at a time
+        mAssetLoader.uploadCompleted(TextureUploadsPerUpdate);
         break;
+    case GameState::Loading:
+        if (mCurrentMenu)
+            mCurrentMenu->update(deltaTime);
+        updateLoading();
+        break;
+    }
+}
+
+void Game::updateFrame(sf::Time deltaTime)
+{
+    if (mGameState == GameState::Playing && mCurrentScene)
+    {
+        mCurrentScene->updateFrame(deltaTime);
     }
 }
 
-void Game::render()
+void Game::render(float alpha)
 {
-    mWindow->clear(sf::Color::White);
+    RenderSnapshot& snapshot = mRenderThread.beginSnapshot();
+    snapshot.clear(sf::Color::White);
+
+    // Only a running simulation moves between steps, anything else shows the latest step
+    if (mCurrentScene)
+    {
+        mCurrentScene->setRenderAlpha(mGameState == GameState::Playing ? alpha : 1.f);
+    }
 
     switch (mGameState)
     {
     case GameState::Playing:
         if (mCurrentScene)
-            mCurrentScene->render(*mWindow);
+            mCurrentScene->render(snapshot);
         break;
     case GameState::Paused:
         if (mCurrentScene)
-            mCurrentScene->render(*mWindow);
+            mCurrentScene->render(snapshot);
         // Draw pause menu on top
     case GameState::MainMenu:
     case GameState::GameOver:
     case GameState::GameWon:
     case GameState::HowToPlay:
+    case GameState::Loading:
+        // Menus are text heavy and cheap, keep them at the native resolution
+        snapshot.beginOverlay();
         if (mCurrentMenu)
-            mCurrentMenu->render();
+            mCurrentMenu->render(snapshot);
         break;
     }
 
-    mWindow->display();
+    mRenderThread.publish();
+}
+
+void Game::closeWindow()
+{
+    // The render thread owns the window's context, so it has to finish before the window goes
+    mRenderThread.stop();
+    if (mWindow)
+    {
+        mWindow->close();
+    }
 }
 
 void Game::setScene(std::unique_ptr<Scene> scene)
 {
+    mRenderThread.flush();
     delete mCurrentScene;  // Delete the old scene
     mCurrentScene = scene.release();  //  ownership to mCurrentScene
     if (mCurrentScene && mWindow)
@@ -245,19 +464,141 @@ void Game::setScene(std::unique_ptr<Scene> scene)
     }
 }
 
+void Game::cycleFastForward()
+{
+    mFastForwardIndex = (mFastForwardIndex + 1) % FastForwardSpeedCount;
+    mSlowMotionIndex = 0;
+    updateSpeedLabel();
+}
+
+void Game::cycleSlowMotion()
+{
+    mSlowMotionIndex = (mSlowMotionIndex + 1) % SlowMotionScaleCount;
+    mFastForwardIndex = 0;
+    updateSpeedLabel();
+}
+
+void Game::resetSimulationSpeed()
+{
+    mFastForwardIndex = 0;
+    mSlowMotionIndex = 0;
+    updateSpeedLabel();
+}
+
+void Game::updateSpeedLabel()
+{
+    int speed = FastForwardSpeeds[mFastForwardIndex];
+    float scale = SlowMotionScales[mSlowMotionIndex];
+
+    std::string label;
+    if (speed != 1)
+    {
+        label = speed == 0 ? "Fast forward: max" : "Fast forward: " + std::to_string(speed) + "x";
+    }
+    else if (scale < 1.f)
+    {
+        label = "Slow motion: " + std::to_string(static_cast<int>(scale * 100.f + 0.5f)) + "%";
+    }
+
+    if (mLevelScene)
+    {
+        mLevelScene->setSpeedLabel(label);
+    }
+    if (!label.empty())
+    {
+        std::cout << label << std::endl;
+    }
+}
+
+sf::Time Game::getScaledTime(sf::Time elapsed) const
+{
+    // Slow motion feeds the accumulator less time, so fewer of the same fixed steps run and
+    // rendering interpolates further between them
+    if (mGameState != GameState::Playing)
+    {
+        return elapsed;
+    }
+    return elapsed * SlowMotionScales[mSlowMotionIndex];
+}
+
+int Game::getStepsPerUpdate() const
+{
+    if (mGameState != GameState::Playing)
+    {
+        return 1;
+    }
+
+    int speed = FastForwardSpeeds[mFastForwardIndex];
+    return speed == 0 ? std::numeric_limits<int>::max() : speed;
+}
+
 void Game::nextLevel()
 {
+    resetSimulationSpeed();
     mCurrentLevelNumber++;
-    if (mCurrentLevelNumber > 3) 
+    if (mCurrentLevelNumber > LastLevel) 
     {
         setState(GameState::GameWon);
     }
+    else if (mNextLevelBuild.valid() && mNextLevelNumber == mCurrentLevelNumber)
+    {
+        // Normally finished long ago, otherwise this waits for the rest of the build
+        std::unique_ptr<LevelScene> level = mNextLevelBuild.get();
+
+        mRenderThread.flush();
+        mLevelScene = std::move(level);
+        mCurrentScene = mLevelScene.get();
+
+        // No frame still refers to the old level, so whatever only it used can go
+        AssetCache::getInstance().releaseUnused();
+        setState(GameState::Playing);
+    }
     else
     {
         loadLevel(mCurrentLevelNumber);
     }
 }
 
+void Game::prebuildNextLevel()
+{
+    int level = mCurrentLevelNumber + 1;
+    if (level > LastLevel || mNextLevelBuild.valid() || !mWindow)
+    {
+        return;
+    }
+
+    // The worker cannot create textures, so wait until everything the level uses is cached
+    for (const std::string& texture : LevelScene::getRequiredTextures())
+    {
+        if (!AssetCache::getInstance().hasTexture(texture))
+        {
+            return;
+        }
+    }
+
+    mNextLevelNumber = level;
+    mNextLevelBuild = buildLevel(level);
+}
+
+std::future<std::unique_ptr<LevelScene>> Game::buildLevel(int level)
+{
+    // The HUD's glyph atlas renders the font, which needs OpenGL, so it is built here and
+    // held until the worker is done. The worker only ever finds it cached.
+    std::shared_ptr<const GlyphAtlas> glyphs = AssetCache::getInstance().getGlyphAtlas(GlyphAtlas::DEFAULT_FONT_PATH);
+
+    sf::RenderWindow* window = mWindow;
+    return std::async(std::launch::async, [window, level, glyphs]()
+        {
+            assert(AssetCache::getInstance().hasGlyphAtlas(GlyphAtlas::DEFAULT_FONT_PATH));
+            sf::Clock buildClock;
+            auto scene = std::make_unique<LevelScene>(level);
+            scene->setWindow(window);
+            scene->initialize();
+            std::cout << "Built level " << level << " in " << buildClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+            return scene;
+        });
+}
+
 void Game::restartLevel()
 {
     loadLevel(mCurrentLevelNumber);
@@ -265,11 +606,13 @@ void Game::restartLevel()
 
 void Game::loadLevel(int levelNumber)
 {
+    resetSimulationSpeed();
     if (!mLevelScene)
     {
-        mLevelScene = std::make_unique<LevelScene>();
-        mLevelScene->setWindow(mWindow);
-        mLevelScene->initialize();
+        // Built behind the loading screen
+        mCurrentLevelNumber = levelNumber;
+        setState(GameState::Playing);
+        return;
     }
 
     mLevelScene->setLevel(levelNumber);
@@ -279,19 +622,28 @@ void Game::loadLevel(int levelNumber)
 
 void Game::resetGameState()
 {
+    mRenderThread.flush();
     mLevelScene.reset();
     mCurrentScene = nullptr;
+    mCurrentLevelNumber = 1;
+    mFastForwardIndex = 0;
+    mSlowMotionIndex = 0;
+
+    // Waits for builds still in flight, then drops the levels they made
+    mLevelBuild = std::future<std::unique_ptr<LevelScene>>();
+    mNextLevelBuild = std::future<std::unique_ptr<LevelScene>>();
+
+    // The level's assets stay cached while the menus are up, so the next Play does not
+    // decode them again. Only level transitions release anything.
 }
 
 void Game::quitGame()
 {
     mIsQuitting = true;
+    mAssetLoader.stop();
 
+    // Stop drawing before anything the last frames reference is released
+    closeWindow();
     resetGameState();
-    mCurrentMenu.reset();
-
-    if (mWindow)
-    {
-        mWindow->close();
-    }
+    mCurrentMenu = nullptr;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define GAME_H
 
 #include <SFML/Graphics.hpp>
+#include <future>
 #include <memory>
 #include "scene.h"
 #include "menu.h"
@@ -11,6 +12,9 @@
 #include "lose_screen.h"
 #include "instructions_screen.h"
 #include "level_scene.h"
+#include "render_thread.h"
+#include "asset_loader.h"
+#include "loading_screen.h"
 
 class Game
 {
@@ -22,7 +26,8 @@ public:
         Paused,
         GameOver,
         GameWon,
-        HowToPlay
+        HowToPlay,
+        Loading
     };
 
     Game();
@@ -39,15 +44,65 @@ public:
 
 private:
     void processEvents();
+
+    // Menus that are not animating redraw only after input, in between the loop sleeps on events
+    // unless textures are still being loaded behind them
+    bool isIdle() const;
+    void waitForEvent();
+    bool mNeedsRedraw;
     void update(sf::Time deltaTime);
-    void render();
+    void updateFrame(sf::Time deltaTime);
+    void render(float alpha);
+    void closeWindow();
+
+    // Queues the given textures and shows the loading screen until they are uploaded,
+    // returns false when there was nothing to load
+    bool beginLoading(const std::vector<std::string>& textures, GameState nextState);
+    void updateLoading();
+
+    // Queues the level's textures while the main menu is up, so Play rarely has to wait for them
+    void preloadLevelAssets();
 
     sf::RenderWindow* mWindow;
-    std::unique_ptr<Menu> mCurrentMenu;
+    RenderThread mRenderThread;
+    Menu* mCurrentMenu; // One of the menus below, they live as long as the game
+    std::unique_ptr<MainMenu> mMainMenu;
+    std::unique_ptr<PauseMenu> mPauseMenu;
+    std::unique_ptr<WinScreen> mWinScreen;
+    std::unique_ptr<LoseScreen> mLoseScreen;
+    std::unique_ptr<InstructionsScreen> mInstructionsScreen;
+    std::unique_ptr<LoadingScreen> mLoadingScreen;
     GameState mGameState;
+    GameState mStateAfterLoading;
+    AssetLoader mAssetLoader;
     static const sf::Time TimePerFrame;
+    static const int MaxUpdatesPerFrame;
+    static const std::size_t TextureUploadsPerUpdate;
+    static const int LastLevel;
+
+    // Fast-forward runs several fixed steps per frame, each exactly the update a 1x frame
+    // runs, so only how many run between two rendered frames changes. A speed of 0 is "max",
+    // which steps until the budget is used up.
+    void cycleFastForward();
+    int getStepsPerUpdate() const;
+    int mFastForwardIndex;
+    static const int FastForwardSpeeds[];
+    static const int FastForwardSpeedCount;
+    static const sf::Time FastForwardBudget;
+
+    // Slow motion scales the time fed to the fixed step accumulator, the step itself never
+    // changes. Per-frame updates keep getting the real time.
+    void cycleSlowMotion();
+    sf::Time getScaledTime(sf::Time elapsed) const;
+    int mSlowMotionIndex;
+    static const float SlowMotionScales[];
+    static const int SlowMotionScaleCount;
+
+    void resetSimulationSpeed();
+    void updateSpeedLabel();
 
     void initializeMenus();
+    void showMenu(Menu* menu);
     void handleMainMenuCallback(int option);
     void handlePauseMenuCallback(int option);
     void handleHowToPlayCallback();
@@ -57,6 +112,15 @@ private:
     int mCurrentLevelNumber;
 
     void loadLevel(int levelNumber);
+
+    // Runs the level's constructor and initialize() on a worker, its textures must be cached
+    std::future<std::unique_ptr<LevelScene>> buildLevel(int level);
+    std::future<std::unique_ptr<LevelScene>> mLevelBuild; // The level about to be played, built behind the loading screen
+
+    // Builds the level after the current one on a worker while the current one is played
+    void prebuildNextLevel();
+    std::future<std::unique_ptr<LevelScene>> mNextLevelBuild;
+    int mNextLevelNumber;
     void resetGameState();
     bool mIsQuitting;
 };
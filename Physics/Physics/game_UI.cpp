@@ -1,4 +1,5 @@
 #include "game_UI.h"
+#include "asset_cache.h"
 #include <iostream>
 
 GameUI::GameUI() : mSelectedProjectileType(Projectile::Type::Standard), mHoveredProjectile(-1)
@@ -8,9 +9,11 @@ GameUI::GameUI() : mSelectedProjectileType(Projectile::Type::Standard), mHovered
 
 void GameUI::initialize(sf::RenderWindow* window)
 {
-    if (!mFont.loadFromFile("dependencies/font.ttf"))
+    mGlyphs = AssetCache::getInstance().getGlyphAtlas(GlyphAtlas::DEFAULT_FONT_PATH);
+    if (!mGlyphs)
     {
         std::cout << "Failed to load font" << std::endl;
+        mGlyphs = std::make_shared<GlyphAtlas>();
     }
 
     loadProjectileTextures();
@@ -20,32 +23,38 @@ void GameUI::initialize(sf::RenderWindow* window)
 
 void GameUI::loadProjectileTextures()
 {
-    mProjectileTextures[0].loadFromFile("dependencies/sprites/standard.png");
-    mProjectileTextures[1].loadFromFile("dependencies/sprites/bouncy.png");
-    mProjectileTextures[2].loadFromFile("dependencies/sprites/explosive.png");
-    mProjectileTextures[3].loadFromFile("dependencies/sprites/heavy.png");
-    mProjectileTextures[4].loadFromFile("dependencies/sprites/split.png");
+    mProjectileTextures[0] = AssetCache::getInstance().getTexture("dependencies/sprites/standard.png");
+    mProjectileTextures[1] = AssetCache::getInstance().getTexture("dependencies/sprites/bouncy.png");
+    mProjectileTextures[2] = AssetCache::getInstance().getTexture("dependencies/sprites/explosive.png");
+    mProjectileTextures[3] = AssetCache::getInstance().getTexture("dependencies/sprites/heavy.png");
+    mProjectileTextures[4] = AssetCache::getInstance().getTexture("dependencies/sprites/split.png");
 }
 
 void GameUI::createUI(sf::RenderWindow* window)
 {
     // Projectiles left text
-    mProjectilesText.setFont(mFont);
+    mProjectilesText.setAtlas(*mGlyphs);
     mProjectilesText.setCharacterSize(24);
     mProjectilesText.setFillColor(sf::Color::White);
     mProjectilesText.setPosition(window->getSize().x - 200, 10);
 
     // Enemies left text
-    mEnemiesText.setFont(mFont);
+    mEnemiesText.setAtlas(*mGlyphs);
     mEnemiesText.setCharacterSize(24);
     mEnemiesText.setFillColor(sf::Color::White);
     mEnemiesText.setPosition(window->getSize().x - 200, 40);
 
     // Level text
-    mLevelText.setFont(mFont);
+    mLevelText.setAtlas(*mGlyphs);
     mLevelText.setCharacterSize(24);
     mLevelText.setFillColor(sf::Color::White);
     mLevelText.setPosition(window->getSize().x / 2 - 50, 10);
+
+    // Fast-forward indicator
+    mSpeedText.setAtlas(*mGlyphs);
+    mSpeedText.setCharacterSize(24);
+    mSpeedText.setFillColor(sf::Color::Yellow);
+    mSpeedText.setPosition(window->getSize().x / 2 - 50, 40);
 }
 
 void GameUI::initializeProjectileSelection()
@@ -56,11 +65,14 @@ void GameUI::initializeProjectileSelection()
 
     for (int i = 0; i < 5; ++i)
     {
-        mProjectileSprites[i].setTexture(mProjectileTextures[i]);
+        if (mProjectileTextures[i])
+        {
+            mProjectileSprites[i].setTexture(*mProjectileTextures[i]);
+        }
         mProjectileSprites[i].setPosition(10 + i * SPRITE_SPACING, SPRITE_Y);
         mProjectileSprites[i].setScale(0.5f, 0.5f);
 
-        mProjectileDescriptions[i].setFont(mFont);
+        mProjectileDescriptions[i].setAtlas(*mGlyphs);
         mProjectileDescriptions[i].setCharacterSize(18);
         mProjectileDescriptions[i].setFillColor(sf::Color::White);
         mProjectileDescriptions[i].setPosition(10 + i * SPRITE_SPACING, DESCRIPTION_Y);
@@ -76,7 +88,7 @@ void GameUI::initializeProjectileSelection()
     mHoveredProjectile = -1;
 
     // Position current projectile type text to the right of the last sprite
-    mCurrentProjectileText.setFont(mFont);
+    mCurrentProjectileText.setAtlas(*mGlyphs);
     mCurrentProjectileText.setCharacterSize(24);
     mCurrentProjectileText.setFillColor(sf::Color::White);
     mCurrentProjectileText.setPosition(10 + 5 * SPRITE_SPACING, SPRITE_Y);
@@ -105,12 +117,16 @@ void GameUI::update(int projectilesLeft, int enemiesLeft, int currentLevel)
     updateCurrentProjectileText();
 }
 
-void GameUI::render(sf::RenderWindow& window)
+void GameUI::render(RenderSnapshot& snapshot)
 {
-    window.draw(mProjectilesText);
-    window.draw(mEnemiesText);
-    window.draw(mLevelText);
-    renderProjectileSelection(window);
+    // Sprites and highlights first, then every HUD string in one batch on top
+    mTextBatch.clear();
+    mTextBatch.add(mProjectilesText);
+    mTextBatch.add(mEnemiesText);
+    mTextBatch.add(mLevelText);
+    mTextBatch.add(mSpeedText);
+    renderProjectileSelection(snapshot);
+    mTextBatch.draw(snapshot);
 }
 
 void GameUI::updateProjectileAvailability(Projectile::Type type, bool available)
@@ -145,11 +161,11 @@ void GameUI::handleProjectileSelection(const sf::Vector2i& mousePosition)
     }
 }
 
-void GameUI::renderProjectileSelection(sf::RenderWindow& window)
+void GameUI::renderProjectileSelection(RenderSnapshot& snapshot)
 {
     for (int i = 0; i < 5; ++i) 
     {
-        window.draw(mProjectileSprites[i]);
+        snapshot.draw(mProjectileSprites[i]);
         if (static_cast<Projectile::Type>(i) == mSelectedProjectileType) 
         {
             // Highlight the selected projectile type
@@ -158,16 +174,16 @@ void GameUI::renderProjectileSelection(sf::RenderWindow& window)
             highlight.setFillColor(sf::Color::Transparent);
             highlight.setOutlineColor(sf::Color::Yellow);
             highlight.setOutlineThickness(2);
-            window.draw(highlight);
+            snapshot.draw(highlight);
         }
     }
 
     if (mHoveredProjectile != -1)
     {
-        window.draw(mProjectileDescriptions[mHoveredProjectile]);
+        mTextBatch.add(mProjectileDescriptions[mHoveredProjectile]);
     }
 
-    window.draw(mCurrentProjectileText);
+    mTextBatch.add(mCurrentProjectileText);
 }
 
 Projectile::Type GameUI::getSelectedProjectileType() const
@@ -3,7 +3,11 @@
 
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <memory>
 #include "projectile.h"
+#include "render_snapshot.h"
+#include "bitmap_text.h"
+#include "text_batch.h"
 
 class GameUI
 {
@@ -12,10 +16,10 @@ public:
     void initialize(sf::RenderWindow* window);
 
     void update(int projectilesLeft, int enemiesLeft, int currentLevel);
-    void render(sf::RenderWindow& window);
+    void render(RenderSnapshot& snapshot);
 
     void handleProjectileSelection(const sf::Vector2i& mousePosition);
-    void renderProjectileSelection(sf::RenderWindow& window);
+    void renderProjectileSelection(RenderSnapshot& snapshot);
     Projectile::Type getSelectedProjectileType() const;
 
     bool isProjectileAvailable(Projectile::Type type) const;
@@ -27,15 +31,20 @@ public:
 
     void initializeProjectileAvailability();
 
-private:
-    sf::Font mFont;
-    sf::Text mProjectilesText;
-    sf::Text mEnemiesText;
-    sf::Text mLevelText;
+    // Shown under the level number, empty at normal speed
+    void setSpeedLabel(const std::string& label) { mSpeedText.setString(label); }
 
-    std::array<sf::Texture, 5> mProjectileTextures;
+private:
+    std::shared_ptr<const GlyphAtlas> mGlyphs;
+    BitmapText mProjectilesText;
+    BitmapText mEnemiesText;
+    BitmapText mLevelText;
+    BitmapText mSpeedText;
+    TextBatch mTextBatch;
+
+    std::array<std::shared_ptr<const sf::Texture>, 5> mProjectileTextures;
     std::array<sf::Sprite, 5> mProjectileSprites;
-    std::array<sf::Text, 5> mProjectileDescriptions;
+    std::array<BitmapText, 5> mProjectileDescriptions;
     Projectile::Type mSelectedProjectileType;
     int mHoveredProjectile;
 
@@ -43,7 +52,7 @@ private:
     void initializeProjectileSelection();
     void updateCurrentProjectileText();
     void loadProjectileTextures();
-    sf::Text mCurrentProjectileText;   
+    BitmapText mCurrentProjectileText;   
 
     std::array<bool, 5> mProjectileAvailability;
 };
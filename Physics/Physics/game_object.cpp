@@ -1,8 +1,11 @@
 #include "game_object.h"
+#include "collision_filter.h"
 #include "physics_world.h"
 #include <iostream>
 
-GameObject::GameObject() : mPhysicsBody(nullptr), mMarkedForDeletion(false) {}
+GameObject::GameObject() : mPhysicsBody(nullptr), mMarkedForDeletion(false),
+mPreviousPosition(0.f, 0.f), mPreviousAngle(0.f), mHasPreviousTransform(false), mWasAwake(true), mNeedsUpdate(true),
+mHasFilterOverride(false) {}
 
 GameObject::~GameObject() {}
 
@@ -91,11 +94,31 @@ void GameObject::setSize(float width, float height)
         fixtureDef.density = 1.0f;
         fixtureDef.friction = 0.3f;
         fixtureDef.restitution = 0.1f;
+        fixtureDef.filter = getCollisionFilter();
 
         mPhysicsBody->CreateFixture(&fixtureDef);
     }
 }
 
+void GameObject::setCollisionFilter(const b2Filter& filter)
+{
+    mFilterOverride = filter;
+    mHasFilterOverride = true;
+
+    if (mPhysicsBody)
+    {
+        for (b2Fixture* fixture = mPhysicsBody->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            fixture->SetFilterData(filter);
+        }
+    }
+}
+
+b2Filter GameObject::getCollisionFilter() const
+{
+    return mHasFilterOverride ? mFilterOverride : CollisionFilter::forKind(getKind());
+}
+
 b2Body* GameObject::getPhysicsBody() const 
 {
     return mPhysicsBody;
@@ -109,7 +132,6 @@ void GameObject::createPhysicsBody(PhysicsWorld& world, b2BodyType type)
         mSprite.getPosition().y * PhysicsWorld::INVERSE_SCALE);
     bodyDef.angle = mSprite.getRotation() * b2_pi / 180.f;
     bodyDef.fixedRotation = false;
-    bodyDef.bullet = true;
     bodyDef.angularDamping = 0.8f;
     bodyDef.linearDamping = 0.1f;
     bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(this);
@@ -140,6 +162,7 @@ void GameObject::createPhysicsBody(PhysicsWorld& world, b2BodyType type)
     fixtureDef.density = 1.0f;
     fixtureDef.friction = 0.3f;
     fixtureDef.restitution = 0.1f;
+    fixtureDef.filter = getCollisionFilter();
 
     b2Fixture* fixture = mPhysicsBody->CreateFixture(&fixtureDef);
 
@@ -149,7 +172,7 @@ void GameObject::createPhysicsBody(PhysicsWorld& world, b2BodyType type)
     }
 }
 
-void GameObject::debugDraw(sf::RenderWindow& window)
+void GameObject::debugDraw(RenderSnapshot& snapshot)
 {
     if (mPhysicsBody)
     {
@@ -168,7 +191,7 @@ void GameObject::debugDraw(sf::RenderWindow& window)
                 shape.setFillColor(sf::Color::Transparent);
                 shape.setOutlineColor(sf::Color::Green);
                 shape.setOutlineThickness(1.0f);
-                window.draw(shape);
+                snapshot.draw(shape);
                 break;
             }
             case b2Shape::e_polygon:
@@ -184,7 +207,7 @@ void GameObject::debugDraw(sf::RenderWindow& window)
                 shape.setFillColor(sf::Color::Transparent);
                 shape.setOutlineColor(sf::Color::Green);
                 shape.setOutlineThickness(1.0f);
-                window.draw(shape);
+                snapshot.draw(shape);
                 break;
             }
             }
@@ -196,3 +219,51 @@ void GameObject::setPhysicsBody(b2Body* body)
 {
     mPhysicsBody = body;
 }
+
+void GameObject::storePreviousTransform()
+{
+    if (mPhysicsBody)
+    {
+        mPreviousPosition = mPhysicsBody->GetPosition();
+        mPreviousAngle = mPhysicsBody->GetAngle();
+        mHasPreviousTransform = true;
+    }
+}
+
+void GameObject::updateSleepState(bool bodyAwake)
+{
+    mNeedsUpdate = bodyAwake || mWasAwake;
+    if (mWasAwake && !bodyAwake)
+    {
+        // Nothing moves while asleep, so interpolate from the resting transform when it wakes
+        storePreviousTransform();
+    }
+    mWasAwake = bodyAwake;
+}
+
+void GameObject::resetInterpolation()
+{
+    mHasPreviousTransform = false;
+}
+
+void GameObject::applyInterpolation(float alpha)
+{
+    // Only the sprite is moved, the body keeps the state of the last physics step
+    if (!mPhysicsBody || !mHasPreviousTransform)
+    {
+        return;
+    }
+
+    b2Vec2 position = mPhysicsBody->GetPosition();
+    float angle = mPhysicsBody->GetAngle();
+
+    float x = mPreviousPosition.x + (position.x - mPreviousPosition.x) * alpha;
+    float y = mPreviousPosition.y + (position.y - mPreviousPosition.y) * alpha;
+    mSprite.setPosition(x * PhysicsWorld::SCALE, y * PhysicsWorld::SCALE);
+
+    if (!mPhysicsBody->IsFixedRotation())
+    {
+        float interpolatedAngle = mPreviousAngle + (angle - mPreviousAngle) * alpha;
+        mSprite.setRotation(interpolatedAngle * 180.f / b2_pi);
+    }
+}
\ No newline at end of file
@@ -3,20 +3,31 @@
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
+#include "render_snapshot.h"
 
 class PhysicsWorld;
 
 class GameObject
 {
 public:
+    enum class Kind
+    {
+        Block,
+        Enemy,
+        Projectile,
+        Debris,
+        Other
+    };
+
     GameObject();
     virtual ~GameObject();
 
     const sf::Sprite& getSprite() const { return mSprite; }
 
     virtual void update(sf::Time deltaTime) = 0;
-    virtual void render(sf::RenderWindow& window) = 0;
+    virtual void render(RenderSnapshot& snapshot) = 0;
     virtual void onCollision(GameObject* other) = 0;
+    virtual Kind getKind() const { return Kind::Other; }
 
     virtual void setPosition(float x, float y);
     virtual void setRotation(float angle);
@@ -26,18 +37,44 @@ public:
     void setTexture(const sf::Texture& texture);
     void setSize(float width, float height);
 
+    // Category and mask for this object's fixtures. CollisionFilter::forKind unless a level
+    // definition overrode it; an override also applies to fixtures that already exist.
+    void setCollisionFilter(const b2Filter& filter);
+    b2Filter getCollisionFilter() const;
+    bool hasCollisionFilterOverride() const { return mHasFilterOverride; }
+
     b2Body* getPhysicsBody() const;
     void createPhysicsBody(PhysicsWorld& world, b2BodyType type);
     void markForDeletion();
     bool isMarkedForDeletion() const;
 
-    virtual void debugDraw(sf::RenderWindow& window);
+    virtual void debugDraw(RenderSnapshot& snapshot);
     void setPhysicsBody(b2Body* body);
 
+    // Render interpolation between the previous and the current physics step
+    void storePreviousTransform();
+    void resetInterpolation();
+    void applyInterpolation(float alpha);
+
+    // Kept by PhysicsWorld after every step. Objects whose body sleeps are skipped by the
+    // scene's update, except once right after falling asleep to sync the resting transform.
+    void updateSleepState(bool bodyAwake);
+    bool needsUpdate() const { return mNeedsUpdate; }
+
 protected:
     sf::Sprite mSprite;
     b2Body* mPhysicsBody;
     bool mMarkedForDeletion;
+
+    b2Vec2 mPreviousPosition;
+    float mPreviousAngle;
+    bool mHasPreviousTransform;
+
+    bool mWasAwake;
+    bool mNeedsUpdate;
+
+    b2Filter mFilterOverride;
+    bool mHasFilterOverride;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "glyph_atlas.h"
+#include <algorithm>
+#include <iostream>
+
+const char* const GlyphAtlas::DEFAULT_FONT_PATH = "dependencies/font.ttf";
+
+GlyphAtlas::GlyphAtlas() {}
+
+const std::vector<unsigned int>& GlyphAtlas::getDefaultSizes()
+{
+    static const std::vector<unsigned int> sizes = { 18, 24, 30, 50, 60 };
+    return sizes;
+}
+
+bool GlyphAtlas::build(const sf::Font& font, const std::vector<unsigned int>& characterSizes)
+{
+    struct Placement
+    {
+        unsigned int characterSize;
+        sf::IntRect source;
+        sf::Vector2i target;
+    };
+
+    mSizes.clear();
+    std::vector<Placement> placements;
+    std::unordered_map<unsigned int, sf::Image> pages;
+
+    // Shelf packing, glyphs go left to right and start a new row when one is full
+    const int spacing = 2 * GLYPH_PADDING;
+    int x = 0;
+    int y = 0;
+    int rowHeight = 0;
+
+    for (unsigned int characterSize : characterSizes)
+    {
+        SizeData& data = mSizes[characterSize];
+        data.lineSpacing = font.getLineSpacing(characterSize);
+
+        for (int i = 0; i < CHARACTER_COUNT; ++i)
+        {
+            sf::Glyph glyph = font.getGlyph(static_cast<sf::Uint32>(FIRST_CHARACTER + i), characterSize, false);
+            if (glyph.textureRect.width <= 0 || glyph.textureRect.height <= 0)
+            {
+                // Whitespace only has an advance
+                data.glyphs[i] = glyph;
+                continue;
+            }
+
+            // The font's page has transparent padding around every glyph, it is copied along
+            sf::IntRect source(glyph.textureRect.left - GLYPH_PADDING, glyph.textureRect.top - GLYPH_PADDING,
+                glyph.textureRect.width + 2 * GLYPH_PADDING, glyph.textureRect.height + 2 * GLYPH_PADDING);
+
+            if (x + source.width > static_cast<int>(ATLAS_WIDTH))
+            {
+                x = 0;
+                y += rowHeight + spacing;
+                rowHeight = 0;
+            }
+
+            placements.push_back({ characterSize, source, sf::Vector2i(x, y) });
+            glyph.textureRect.left = x + GLYPH_PADDING;
+            glyph.textureRect.top = y + GLYPH_PADDING;
+            data.glyphs[i] = glyph;
+
+            x += source.width + spacing;
+            rowHeight = std::max(rowHeight, source.height);
+        }
+
+        // Every glyph of this size is on the font's page now
+        pages[characterSize] = font.getTexture(characterSize).copyToImage();
+    }
+
+    sf::Image image;
+    image.create(ATLAS_WIDTH, std::max(1, y + rowHeight), sf::Color(255, 255, 255, 0));
+    for (const Placement& placement : placements)
+    {
+        image.copy(pages[placement.characterSize], placement.target.x, placement.target.y, placement.source);
+    }
+
+    if (!mTexture.loadFromImage(image))
+    {
+        std::cout << "Failed to create glyph atlas texture" << std::endl;
+        mSizes.clear();
+        return false;
+    }
+    mTexture.setSmooth(true);
+    return true;
+}
+
+const sf::Glyph* GlyphAtlas::getGlyph(char character, unsigned int characterSize) const
+{
+    auto it = mSizes.find(characterSize);
+    if (it == mSizes.end() || character < FIRST_CHARACTER || character > LAST_CHARACTER)
+    {
+        return nullptr;
+    }
+    return &it->second.glyphs[character - FIRST_CHARACTER];
+}
+
+float GlyphAtlas::getLineSpacing(unsigned int characterSize) const
+{
+    auto it = mSizes.find(characterSize);
+    return it != mSizes.end() ? it->second.lineSpacing : static_cast<float>(characterSize);
+}
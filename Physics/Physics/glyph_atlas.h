@@ -0,0 +1,49 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+// Every printable ASCII glyph of a font, rasterised once at a fixed set of character
+// sizes and packed into a single texture, so any amount of text can be drawn in one batch.
+class GlyphAtlas
+{
+public:
+    GlyphAtlas();
+
+    // Needs an OpenGL context, build on the main thread
+    bool build(const sf::Font& font, const std::vector<unsigned int>& characterSizes);
+
+    // Returns nullptr for characters or sizes that are not in the atlas
+    const sf::Glyph* getGlyph(char character, unsigned int characterSize) const;
+    float getLineSpacing(unsigned int characterSize) const;
+    const sf::Texture& getTexture() const { return mTexture; }
+
+    // Every character size the menus and the HUD use
+    static const std::vector<unsigned int>& getDefaultSizes();
+
+    // The one font the menus and the HUD are set in
+    static const char* const DEFAULT_FONT_PATH;
+
+    // Glyph quads are grown by this much on each side so smoothing does not clip the edges
+    static const int GLYPH_PADDING = 1;
+
+private:
+    static const char FIRST_CHARACTER = ' ';
+    static const char LAST_CHARACTER = '~';
+    static const int CHARACTER_COUNT = LAST_CHARACTER - FIRST_CHARACTER + 1;
+    static const unsigned int ATLAS_WIDTH = 1024;
+
+    struct SizeData
+    {
+        std::array<sf::Glyph, CHARACTER_COUNT> glyphs;
+        float lineSpacing;
+    };
+
+    std::unordered_map<unsigned int, SizeData> mSizes;
+    sf::Texture mTexture;
+};
+
+#endif
@@ -1,22 +1,27 @@
 #include "instructions_screen.h"
+#include "asset_cache.h"
 #include <iostream>
 
 InstructionsScreen::InstructionsScreen(sf::RenderWindow& window, std::function<void()> backCallback)
     : Menu(window), mBackCallback(backCallback) 
 {
-    if (!mBackgroundTexture.loadFromFile("dependencies/sprites/menu.png")) 
+    mBackgroundTexture = AssetCache::getInstance().getTexture("dependencies/sprites/menu.png");
+    if (!mBackgroundTexture)
     {
         std::cout << "Failed to load how to play background image" << std::endl;
     }
-    mBackgroundSprite.setTexture(mBackgroundTexture);
+    else
+    {
+        mBackgroundSprite.setTexture(*mBackgroundTexture);
 
-    // Scale the background to fit the window
-    float scaleX = window.getSize().x / static_cast<float>(mBackgroundTexture.getSize().x);
-    float scaleY = window.getSize().y / static_cast<float>(mBackgroundTexture.getSize().y);
-    mBackgroundSprite.setScale(scaleX, scaleY);
+        // Scale the background to fit the window
+        float scaleX = window.getSize().x / static_cast<float>(mBackgroundTexture->getSize().x);
+        float scaleY = window.getSize().y / static_cast<float>(mBackgroundTexture->getSize().y);
+        mBackgroundSprite.setScale(scaleX, scaleY);
+    }
 
     // Set up instructions text
-    mInstructionsText.setFont(mFont);
+    mInstructionsText.setAtlas(*mGlyphs);
     mInstructionsText.setString
     (
         "How to Play:\n\n"
@@ -25,14 +30,15 @@ InstructionsScreen::InstructionsScreen(sf::RenderWindow& window, std::function<v
         "3. Destroy all the enemies and if you want to, the blocks\n"
         "4. Click and hover on the UI sprites in the top left to change projectile\n"
         "5. Press 'Esc' to pause the game\n"
-        "6. Please give good grade"
+        "6. Press 'F' to fast forward or 'S' for slow motion\n"
+        "7. Please give good grade"
     );
     mInstructionsText.setCharacterSize(30);
     mInstructionsText.setFillColor(sf::Color::White);
     mInstructionsText.setPosition(50, 50);
 
     // Set up back button
-    mBackButtonText.setFont(mFont);
+    mBackButtonText.setAtlas(*mGlyphs);
     mBackButtonText.setString("Back");
     mBackButtonText.setCharacterSize(30);
     mBackButtonText.setFillColor(sf::Color::White);
@@ -43,12 +49,12 @@ void InstructionsScreen::handleEvent(const sf::Event& event)
 {
     if (event.type == sf::Event::MouseMoved) 
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         updateButtonHover(mousePos);
     }
     if (event.type == sf::Event::MouseButtonPressed) 
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         if (mBackButtonText.getGlobalBounds().contains(mousePos)) 
         {
             mBackCallback();
@@ -60,9 +66,12 @@ void InstructionsScreen::update(sf::Time deltaTime)
 {
 }
 
-void InstructionsScreen::render() 
+void InstructionsScreen::render(RenderSnapshot& snapshot) 
 {
-    mWindow.draw(mBackgroundSprite);
-    mWindow.draw(mInstructionsText);
-    mWindow.draw(mBackButtonText);
+    snapshot.draw(mBackgroundSprite);
+
+    mTextBatch.clear();
+    mTextBatch.add(mInstructionsText);
+    mTextBatch.add(mBackButtonText);
+    mTextBatch.draw(snapshot);
 }
\ No newline at end of file
@@ -11,13 +11,13 @@ public:
 
     void handleEvent(const sf::Event& event) override;
     void update(sf::Time deltaTime) override;
-    void render() override;
+    void render(RenderSnapshot& snapshot) override;
 
 private:
     sf::Sprite mBackgroundSprite;
-    sf::Texture mBackgroundTexture;
-    sf::Text mInstructionsText;
-    sf::Text mBackButtonText;
+    std::shared_ptr<const sf::Texture> mBackgroundTexture;
+    BitmapText mInstructionsText;
+    BitmapText mBackButtonText;
     std::function<void()> mBackCallback;
 };
 
@@ -27,9 +27,9 @@ void JointObject::update(sf::Time deltaTime)
     }
 }
 
-void JointObject::render(sf::RenderWindow& window)
+void JointObject::render(RenderSnapshot& snapshot)
 {
-    window.draw(mSprite);
+    snapshot.draw(mSprite);
 }
 
 void JointObject::onCollision(GameObject* other)
@@ -20,7 +20,7 @@ public:
     ~JointObject();
 
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow& window) override;
+    void render(RenderSnapshot& snapshot) override;
     void onCollision(GameObject* other) override;
 
     void createJoint(b2Body* bodyA, b2Body* bodyB);
@@ -1,10 +1,15 @@
 #include "level_scene.h"
+#include "collision_filter.h"
+#include "asset_cache.h"
 #include "block.h"
 #include "enemy.h"
 #include "projectile.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 
 const float SCALE = 30.f;
 
@@ -18,76 +23,151 @@ inline float toPixel(float meter)
     return meter * SCALE;
 }
 
-LevelScene::LevelScene() : mCurrentLevel(1), mIsDragging(false), mDebugDraw(false),
-mProjectileLaunched(false), mProjectilesLeft(MAX_PROJECTILES), mEnemiesLeft(0),
-mLevelCompleted(false), mLevelFailed(false), mFinalProjectileLaunched(false) {}
+LevelScene::LevelScene(int level) : mCurrentLevel(level), mIsDragging(false), mTrajectoryAwakeSetChanges(0), mDebugDraw(false),
+mProjectileLaunched(false), mProjectilesLeft(MAX_PROJECTILES), mEnemiesLeft(0), mCountedObjectCount(0),
+mLevelCompleted(false), mLevelFailed(false), mFinalProjectileLaunched(false),
+mWorldWidth(PhysicsWorld::DEFAULT_WORLD_WIDTH), mWorldHeight(PhysicsWorld::DEFAULT_WORLD_HEIGHT),
+mInitialStateLevel(0), mInitialBodyCount(0), mInitialStateSettled(false), mUseBakedLayout(true) {}
+
+const char* const LevelScene::BAKED_LAYOUT_PATH = "dependencies/levels.bake";
+
+const std::vector<std::string>& LevelScene::getRequiredTextures()
+{
+    static const std::vector<std::string> textures = {
+        "dependencies/sprites/background.jpg",
+        "dependencies/sprites/ground.png",
+        "dependencies/sprites/box.png",
+        "dependencies/sprites/spider.png",
+        "dependencies/sprites/fireball.png",
+        "dependencies/sprites/standard.png",
+        "dependencies/sprites/bouncy.png",
+        "dependencies/sprites/explosive.png",
+        "dependencies/sprites/heavy.png",
+        "dependencies/sprites/split.png"
+    };
+    return textures;
+}
 
 void LevelScene::initialize()
 {
-    // Load textures
-    if (!mBackgroundTexture.loadFromFile("dependencies/sprites/background.jpg") ||
-        !mGroundTexture.loadFromFile("dependencies/sprites/ground.png") ||
-        !mBlockTexture.loadFromFile("dependencies/sprites/box.png") ||
-        !mEnemyTexture.loadFromFile("dependencies/sprites/spider.png") ||
-        !mFireballTexture.loadFromFile("dependencies/sprites/fireball.png"))
+    // Load textures, shared with every other user of the same files
+    AssetCache& assets = AssetCache::getInstance();
+    mBackgroundTexture = assets.getTexture("dependencies/sprites/background.jpg");
+    mGroundTexture = assets.getTexture("dependencies/sprites/ground.png");
+    mBlockTexture = assets.getTexture("dependencies/sprites/box.png");
+    mEnemyTexture = assets.getTexture("dependencies/sprites/spider.png");
+    mFireballTexture = assets.getTexture("dependencies/sprites/fireball.png");
+
+    if (!mBackgroundTexture || !mGroundTexture || !mBlockTexture || !mEnemyTexture || !mFireballTexture)
     {
         std::cout << "Failed to load textures" << std::endl;
         return;
     }
 
     loadProjectileTextures();
+    configureWorldBounds();
 
     // Set up background
-    mBackgroundSprite.setTexture(mBackgroundTexture);
+    mBackgroundSprite.setTexture(*mBackgroundTexture);
     mBackgroundSprite.setScale
     (
-        getWindow()->getSize().x / static_cast<float>(mBackgroundTexture.getSize().x),
-        getWindow()->getSize().y / static_cast<float>(mBackgroundTexture.getSize().y)
+        getWindow()->getSize().x / static_cast<float>(mBackgroundTexture->getSize().x),
+        getWindow()->getSize().y / static_cast<float>(mBackgroundTexture->getSize().y)
     );
 
     // Set up ground
-    mGroundSprite.setTexture(mGroundTexture);
+    mGroundSprite.setTexture(*mGroundTexture);
     mGroundSprite.setTextureRect(sf::IntRect(0, 0, getWindow()->getSize().x, GROUND_HEIGHT));
     mGroundSprite.setPosition(0, getWindow()->getSize().y - GROUND_HEIGHT);
 
     // Set up fireball sprite
-    mFireballSprite.setTexture(mFireballTexture);
-    mFireballSprite.setOrigin(mFireballTexture.getSize().x / 1.0f, mFireballTexture.getSize().y / 2.f);
+    mFireballSprite.setTexture(*mFireballTexture);
+    mFireballSprite.setOrigin(mFireballTexture->getSize().x / 1.0f, mFireballTexture->getSize().y / 2.f);
     mFireballSprite.setPosition(mSlingshotPos);
 
     // Set up slingshot
-    mSlingshotPos = sf::Vector2f(200.f, getWindow()->getSize().y - GROUND_HEIGHT - SLINGSHOT_HEIGHT);
+    mSlingshotPos = sf::Vector2f(200.f, toPixel(mWorldHeight) - GROUND_HEIGHT - SLINGSHOT_HEIGHT);
     mSlingshotBase.setSize(sf::Vector2f(SLINGSHOT_WIDTH, SLINGSHOT_HEIGHT));
     mSlingshotBase.setFillColor(sf::Color::Yellow);
     mSlingshotBase.setPosition(mSlingshotPos.x - SLINGSHOT_WIDTH / 2, mSlingshotPos.y);
 
+    // Destroyed blocks break up where they were hit
+    mPhysicsWorld.onMarkedBodyDestroyed = [this](GameObject& object, const b2Body& body)
+    {
+        if (Block* block = dynamic_cast<Block*>(&object))
+        {
+            mDebrisPool.fracture(body, block->getImpactPoint());
+        }
+    };
+
     createGround();
-    createBlocks();
-    createEnemies();
+    mDebrisPool.initialize(mPhysicsWorld, mBlockTexture.get());
+    loadInitialState();
+    spawnInitialState();
     createProjectile();
 
     updateUI(mProjectilesLeft, mEnemiesLeft, mCurrentLevel);
+}
+
+void LevelScene::loadProjectileTextures()
+{
+    mProjectileTextures[0] = AssetCache::getInstance().getTexture("dependencies/sprites/standard.png");
+    mProjectileTextures[1] = AssetCache::getInstance().getTexture("dependencies/sprites/bouncy.png");
+    mProjectileTextures[2] = AssetCache::getInstance().getTexture("dependencies/sprites/explosive.png");
+    mProjectileTextures[3] = AssetCache::getInstance().getTexture("dependencies/sprites/heavy.png");
+    mProjectileTextures[4] = AssetCache::getInstance().getTexture("dependencies/sprites/split.png");
+}
 
-    if (!mDebugFont.loadFromFile("dependencies/font.ttf"))
+void LevelScene::configureWorldBounds()
+{
+    // Level width in metres, later levels run well past the edge of the window so shots that
+    // clear the structure stay in play and the camera follows them out
+    mWorldHeight = PhysicsWorld::DEFAULT_WORLD_HEIGHT;
+    switch (mCurrentLevel)
     {
-        std::cout << "Failed to load debug font" << std::endl;
+    case 2:
+        mWorldWidth = 1.5f * PhysicsWorld::DEFAULT_WORLD_WIDTH;
+        break;
+    case 3:
+        mWorldWidth = 2.f * PhysicsWorld::DEFAULT_WORLD_WIDTH;
+        break;
+    default:
+        mWorldWidth = PhysicsWorld::DEFAULT_WORLD_WIDTH;
+        break;
     }
+
+    // Objects are only lost once they leave the level, with headroom above it for high arcs
+    b2AABB bounds;
+    bounds.lowerBound.Set(0.f, -WORLD_HEADROOM);
+    bounds.upperBound.Set(mWorldWidth, mWorldHeight);
+    mPhysicsWorld.setWorldBounds(bounds);
+
+    mCamera.setBounds(sf::FloatRect(0.f, toPixel(-WORLD_HEADROOM), toPixel(mWorldWidth), toPixel(mWorldHeight + WORLD_HEADROOM)));
+
+    // Rest the camera on the bottom left of the level, where the slingshot is
+    sf::Vector2f viewSize = mCamera.getView().getSize();
+    mCameraHome = sf::Vector2f(viewSize.x / 2.f, toPixel(mWorldHeight) - viewSize.y / 2.f);
+    mCamera.setCenter(mCameraHome);
 }
 
-void LevelScene::loadProjectileTextures()
+void LevelScene::updateCamera()
 {
-    mProjectileTextures[0].loadFromFile("dependencies/sprites/standard.png");
-    mProjectileTextures[1].loadFromFile("dependencies/sprites/bouncy.png");
-    mProjectileTextures[2].loadFromFile("dependencies/sprites/explosive.png");
-    mProjectileTextures[3].loadFromFile("dependencies/sprites/heavy.png");
-    mProjectileTextures[4].loadFromFile("dependencies/sprites/split.png");
+    // Follow the most recently launched projectile, and return to the slingshot once the shot is over
+    for (auto it = mProjectiles.rbegin(); it != mProjectiles.rend(); ++it)
+    {
+        if ((*it)->isLaunched() && (*it)->getPhysicsBody())
+        {
+            mCamera.follow((*it)->getPosition());
+            return;
+        }
+    }
 }
 
 void LevelScene::createGround()
 {
     std::cout << "Creating ground..." << std::endl;
-    float groundWidth = getWindow()->getSize().x;
-    float groundY = getWindow()->getSize().y - GROUND_HEIGHT;
+    float groundWidth = toPixel(mWorldWidth);
+    float groundY = toPixel(mWorldHeight) - GROUND_HEIGHT;
 
     b2BodyDef groundBodyDef;
     groundBodyDef.type = b2_staticBody;
@@ -105,29 +185,33 @@ void LevelScene::createGround()
     groundFixtureDef.friction = 0.3f;
     groundFixtureDef.restitution = 0.1f;
     groundFixtureDef.density = 0.0f;
+    groundFixtureDef.filter = CollisionFilter::forGround();
 
     groundBody->CreateFixture(&groundFixtureDef);
 
     mGroundShape = std::make_unique<sf::RectangleShape>(sf::Vector2f(groundWidth, GROUND_HEIGHT));
     mGroundShape->setPosition(0, groundY);
-    mGroundShape->setTexture(&mGroundTexture);
+    mGroundShape->setTexture(mGroundTexture.get());
 
     std::cout << "Ground creation complete." << std::endl;
 }
 
-void LevelScene::render(sf::RenderWindow& window)
+void LevelScene::render(RenderSnapshot& snapshot)
 {
-    window.draw(mBackgroundSprite);
+    // Background stays fixed to the screen, everything else is drawn through the camera
+    snapshot.draw(mBackgroundSprite);
+    snapshot.setView(mCamera.getView());
 
     if (mGroundShape)
     {
-        window.draw(*mGroundShape);
+        snapshot.draw(*mGroundShape);
     }
 
-    Scene::render(window);
-
     // Draw slingshot
-    window.draw(mSlingshotBase);
+    snapshot.draw(mSlingshotBase);
+
+    // Draw blocks and enemies found by the broadphase
+    renderVisibleObjects(snapshot);
 
     // Draw trajectory
     if (mIsDragging && !mTrajectoryPoints.empty())
@@ -138,13 +222,14 @@ void LevelScene::render(sf::RenderWindow& window)
             trajectory[i].position = mTrajectoryPoints[i];
             trajectory[i].color = sf::Color::Red;
         }
-        window.draw(trajectory);
+        snapshot.draw(trajectory);
     }
 
-    // Draw projectiles
+    // Draw projectiles, including spent ones that are only kept for their explosion
     for (const auto& projectile : mProjectiles)
     {
-        projectile->render(window);
+        projectile->applyInterpolation(mRenderAlpha);
+        projectile->render(snapshot);
     }
 
     if (mDebugDraw)
@@ -168,7 +253,7 @@ void LevelScene::render(sf::RenderWindow& window)
                     shape.setFillColor(sf::Color::Transparent);
                     shape.setOutlineColor(sf::Color::Green);
                     shape.setOutlineThickness(1);
-                    window.draw(shape);
+                    snapshot.draw(shape);
                     break;
                 }
                 case b2Shape::e_polygon:
@@ -184,7 +269,7 @@ void LevelScene::render(sf::RenderWindow& window)
                     shape.setFillColor(sf::Color::Transparent);
                     shape.setOutlineColor(sf::Color::Green);
                     shape.setOutlineThickness(1);
-                    window.draw(shape);
+                    snapshot.draw(shape);
                     break;
                 }
                 }
@@ -193,7 +278,8 @@ void LevelScene::render(sf::RenderWindow& window)
         }
     }
 
-    mGameUI.renderProjectileSelection(window);
+    snapshot.beginOverlay();
+    mGameUI.render(snapshot);
 }
 
 void LevelScene::handleEvent(const sf::Event& event)
@@ -203,6 +289,8 @@ void LevelScene::handleEvent(const sf::Event& event)
         mDebugDraw = !mDebugDraw;
     }
 
+    mCamera.handleEvent(event, *getWindow());
+
     if (event.type == sf::Event::MouseMoved)
     {
         mGameUI.handleMouseHover(sf::Mouse::getPosition(*getWindow()));
@@ -220,10 +308,18 @@ void LevelScene::handleEvent(const sf::Event& event)
 
         if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)
         {
-            sf::Vector2f mousePos = getWindow()->mapPixelToCoords(sf::Mouse::getPosition(*getWindow()));
+            sf::Vector2f mousePos = getWindow()->mapPixelToCoords(sf::Mouse::getPosition(*getWindow()), mCamera.getView());
             if (mProjectiles.back()->getSprite().getGlobalBounds().contains(mousePos))
             {
                 mIsDragging = true;
+
+                // Debris that was still moving when the copy was taken, or anything that woke
+                // or came to rest since, has left the copy behind
+                if (mTrajectoryPredictor.hasSkippedAwakeBodies() ||
+                    mTrajectoryAwakeSetChanges != mPhysicsWorld.getAwakeSetChanges())
+                {
+                    mTrajectoryPredictor.invalidate();
+                }
             }
         }
 
@@ -235,7 +331,7 @@ void LevelScene::handleEvent(const sf::Event& event)
 
         if (event.type == sf::Event::MouseMoved && mIsDragging)
         {
-            sf::Vector2f mousePos = getWindow()->mapPixelToCoords(sf::Mouse::getPosition(*getWindow()));
+            sf::Vector2f mousePos = getWindow()->mapPixelToCoords(sf::Mouse::getPosition(*getWindow()), mCamera.getView());
             sf::Vector2f pull = (mSlingshotPos + projectileOffset) - mousePos;
             float pullLength = std::sqrt(pull.x * pull.x + pull.y * pull.y);
             if (pullLength > MAX_PULL_DISTANCE)
@@ -253,6 +349,7 @@ void LevelScene::handleEvent(const sf::Event& event)
 void LevelScene::update(sf::Time deltaTime)
 {
     Scene::update(deltaTime);
+    mDebrisPool.update(deltaTime);
 
     // Process ending split projectile
     for (const auto& action : mPendingActions)
@@ -261,14 +358,12 @@ void LevelScene::update(sf::Time deltaTime)
     }
     mPendingActions.clear();
 
-    updateTrajectory();
-
     // Update projectiles
     for (auto it = mProjectiles.begin(); it != mProjectiles.end();)
     {
         (*it)->update(deltaTime);
 
-        if ((*it)->hasExceededLifetime() || isProjectileOffScreen(*it))
+        if ((*it)->hasExceededLifetime() || isProjectileOutOfBounds(*it))
         {
             mPhysicsWorld.destroyBody((*it)->getPhysicsBody());
             it = mProjectiles.erase(it);
@@ -292,9 +387,35 @@ void LevelScene::update(sf::Time deltaTime)
         }
     }
 
+    // Settled debris and a projectile at rest end the shot straight away
+    if (mProjectileLaunched && !mProjectiles.empty() && mPendingActions.empty() && mPhysicsWorld.isQuiescent(QUIESCENT_ENERGY))
+    {
+        // isEffectActive() stays true for a bouncy projectile's whole life, only a running
+        // explosion holds the shot open
+        bool effectActive = false;
+        for (const auto& projectile : mProjectiles)
+        {
+            effectActive = effectActive || projectile->isExplosionActive();
+        }
+
+        mQuiescentTime = effectActive ? sf::Time::Zero : mQuiescentTime + deltaTime;
+        if (mQuiescentTime >= QUIESCENT_TIME)
+        {
+            endShot();
+        }
+    }
+    else
+    {
+        mQuiescentTime = sf::Time::Zero;
+    }
+
     // Reset mProjectileLaunched if no projectiles are active
     if (mProjectiles.empty())
     {
+        if (mProjectileLaunched)
+        {
+            mCamera.follow(mCameraHome);
+        }
         mProjectileLaunched = false;
         if (mProjectilesLeft > 0)
         {
@@ -308,16 +429,39 @@ void LevelScene::update(sf::Time deltaTime)
     }
 
     checkLevelCompletion();
-    updateUI(mProjectilesLeft, mEnemiesLeft, mCurrentLevel);
     removeDestroyedObjects();
 }
 
+void LevelScene::updateFrame(sf::Time deltaTime)
+{
+    // Aiming, the camera and the HUD answer the player in real time, also in slow motion
+    updateTrajectory();
+    updateCamera();
+    Scene::updateFrame(deltaTime);
+    updateUI(mProjectilesLeft, mEnemiesLeft, mCurrentLevel);
+}
+
+void LevelScene::endShot()
+{
+    std::cout << "World settled, ending the shot" << std::endl;
+    for (const auto& projectile : mProjectiles)
+    {
+        mPhysicsWorld.destroyBody(projectile->getPhysicsBody());
+    }
+    mProjectiles.clear();
+
+    // Whatever still creeps along stops here, and the world is not stepped again until
+    // the next launch wakes it
+    mPhysicsWorld.sleepAll();
+    mQuiescentTime = sf::Time::Zero;
+}
+
 void LevelScene::createProjectile()
 {
     Projectile::Type type = mGameUI.getSelectedProjectileType();
     sf::Vector2f position(mSlingshotPos.x - 40.f, mSlingshotPos.y - 40.f);
 
-    auto projectile = std::make_unique<Projectile>(mPhysicsWorld, mFireballTexture, type, mWindow, position);
+    auto projectile = std::make_unique<Projectile>(mPhysicsWorld, *mFireballTexture, type, mWindow, position);
 
     if (!mGameUI.isProjectileAvailable(type))
     {
@@ -349,7 +493,7 @@ void LevelScene::createProjectile()
                         auto newProjectile = std::make_unique<Projectile>
                             (
                             mPhysicsWorld,
-                            mFireballTexture,
+                            *mFireballTexture,
                             Projectile::Type::Standard,
                             mWindow,
                             newPosition
@@ -368,7 +512,7 @@ void LevelScene::createProjectile()
 
     // Increase the size of the projectile
     float scaleFactor = 5.0f;
-    sf::Vector2u textureSize = mFireballTexture.getSize();
+    sf::Vector2u textureSize = mFireballTexture->getSize();
     float newWidth = textureSize.x * scaleFactor;
     float newHeight = textureSize.y * scaleFactor;
     projectile->setSize(newWidth, newHeight);
@@ -380,21 +524,18 @@ void LevelScene::launchProjectile()
 {
     if (!mProjectiles.empty() && !mProjectileLaunched)
     {
-        sf::Vector2f pull = mSlingshotPos - mDragPosition;
-        float pullLength = std::sqrt(pull.x * pull.x + pull.y * pull.y);
-        if (pullLength > MAX_PULL_DISTANCE)
+        sf::Vector2f direction;
+        float force;
+        if (!computeLaunch(mSlingshotPos - mDragPosition, direction, force))
         {
-            pull = (pull / pullLength) * MAX_PULL_DISTANCE;
-            pullLength = MAX_PULL_DISTANCE;
+            return;
         }
 
-        sf::Vector2f direction = pull / pullLength;
-        float force = pullLength * SCALING_FACTOR;
-
         mProjectiles.back()->launch(direction, force);
+        mTrajectoryPredictor.invalidate(); // The level is about to move
         mProjectilesLeft--;
         mProjectileLaunched = true;
-        mProjectileLifetime.restart();
+        mQuiescentTime = sf::Time::Zero;
 
         if (mProjectilesLeft == 0)
         {
@@ -412,37 +553,57 @@ void LevelScene::updateTrajectory()
 {
     if (mIsDragging && !mProjectiles.empty())
     {
-        mTrajectoryPoints.clear();
+        b2Body* body = mProjectiles.back()->getPhysicsBody();
+        if (!body)
+        {
+            mTrajectoryPoints.clear();
+            return;
+        }
 
-        sf::Vector2f pull = mSlingshotPos - mDragPosition;
-        float pullLength = std::sqrt(pull.x * pull.x + pull.y * pull.y);
-        if (pullLength > MAX_PULL_DISTANCE)
+        // The level usually rests while aiming, so one copy of it serves every drag until the
+        // next launch or until something in it moves
+        if (!mTrajectoryPredictor.isBuilt())
         {
-            pull = (pull / pullLength) * MAX_PULL_DISTANCE;
-            pullLength = MAX_PULL_DISTANCE;
+            mTrajectoryPredictor.rebuild(*mPhysicsWorld.getWorld(), body, mPhysicsWorld.getWorldBounds());
+            mTrajectoryAwakeSetChanges = mPhysicsWorld.getAwakeSetChanges();
         }
+        mTrajectoryPredictor.setProjectile(body, static_cast<int>(mProjectiles.back()->getType()),
+            mProjectiles.back()->getBounceFactor());
+        mTrajectoryPredictor.setSolverSettings(mPhysicsWorld.getSolverController().getSettings());
 
-        sf::Vector2f direction = pull / pullLength;
-        float force = pullLength * SCALING_FACTOR;
+        // The preview is taken from the quantised pull, so every drag position with the same
+        // key shares one path. Start and velocity follow from it as launchProjectile() derives them.
+        sf::Vector2f pull = mSlingshotPos - mDragPosition;
+        sf::Vector2i quantisedPull(static_cast<int>(std::round(pull.x / PULL_QUANTUM)), static_cast<int>(std::round(pull.y / PULL_QUANTUM)));
+        pull = sf::Vector2f(quantisedPull) * PULL_QUANTUM;
+
+        sf::Vector2f direction;
+        float force;
+        if (!computeLaunch(pull, direction, force))
+        {
+            mTrajectoryPoints.clear();
+            return;
+        }
 
-        // Convert to Box2D coordinates and scaling
         b2Vec2 initialVelocity(direction.x * force * PhysicsWorld::INVERSE_SCALE,
             direction.y * force * PhysicsWorld::INVERSE_SCALE);
+        b2Vec2 position(toBox2D(mSlingshotPos.x - pull.x), toBox2D(mSlingshotPos.y - pull.y));
+        int stepsPerPoint = std::max(1, static_cast<int>(std::round(TIME_STEP_TRAJECTORY / TrajectoryPredictor::TIME_STEP)));
 
-        b2Vec2 gravity = mPhysicsWorld.getWorld()->GetGravity();
-        b2Vec2 position(toBox2D(mSlingshotPos.x), toBox2D(mSlingshotPos.y));
-
-        for (int i = 1; i <= NUM_POINTS; ++i)
-        {
-            float t = i * TIME_STEP_TRAJECTORY;
-
-            // Use Box2D physics equations
-            float x = position.x + initialVelocity.x * t;
-            float y = position.y + initialVelocity.y * t + 0.5f * gravity.y * t * t;
+        mTrajectoryPoints = mTrajectoryPredictor.predict(quantisedPull, position, initialVelocity, NUM_POINTS, stepsPerPoint);
+    }
+}
 
-            mTrajectoryPoints.emplace_back(toPixel(x), toPixel(y));
-        }
+bool LevelScene::computeLaunch(const sf::Vector2f& pull, sf::Vector2f& direction, float& force) const
+{
+    float pullLength = std::sqrt(pull.x * pull.x + pull.y * pull.y);
+    if (pullLength <= 0.f)
+    {
+        return false;
     }
+    direction = pull / pullLength;
+    force = std::min(pullLength, MAX_PULL_DISTANCE) * SCALING_FACTOR;
+    return true;
 }
 
 void LevelScene::resetProjectile()
@@ -456,18 +617,9 @@ void LevelScene::resetProjectile()
     }
 }
 
-void LevelScene::createEnemies()
+void LevelScene::layoutEnemies()
 {
-    // Clear existing enemies
-    mGameObjects.erase(
-        std::remove_if(mGameObjects.begin(), mGameObjects.end(),
-            [](const std::unique_ptr<GameObject>& obj) 
-            {
-                return dynamic_cast<Enemy*>(obj.get()) != nullptr;
-            }),
-        mGameObjects.end());
-
-    // Create enemies based on current level
+    // Authored enemy positions for the current level
     std::vector<sf::Vector2f> enemyPositions;
     switch (mCurrentLevel)
     {
@@ -487,24 +639,24 @@ void LevelScene::createEnemies()
 
     for (const auto& pos : enemyPositions)
     {
-        auto enemy = std::make_unique<Enemy>(mEnemyTexture, 80.f, 80.f);
-        enemy->setPosition(pos.x, pos.y);
-        enemy->initPhysicsBody(mPhysicsWorld);
-        mGameObjects.push_back(std::move(enemy));
+        mInitialState.push_back({ ObjectSpawn::Kind::Enemy, pos, 0.f, sf::Vector2f(80.f, 80.f) });
     }
-
-    mEnemiesLeft = enemyPositions.size();
 }
 
 void LevelScene::checkLevelCompletion()
 {
-    mEnemiesLeft = 0;
-    for (const auto& obj : mGameObjects)
+    // Objects only ever leave mGameObjects after the spawn, so the count holds until it shrinks
+    if (mGameObjects.size() != mCountedObjectCount)
     {
-        if (dynamic_cast<Enemy*>(obj.get()))
+        mEnemiesLeft = 0;
+        for (const auto& obj : mGameObjects)
         {
-            mEnemiesLeft++;
+            if (dynamic_cast<Enemy*>(obj.get()))
+            {
+                mEnemiesLeft++;
+            }
         }
+        mCountedObjectCount = mGameObjects.size();
     }
 
     updateUI(mProjectilesLeft, mEnemiesLeft, mCurrentLevel);
@@ -547,54 +699,37 @@ void LevelScene::printAllBodies()
     std::cout << "Total bodies: " << bodyCount << std::endl;
 }
 
-void LevelScene::createBlocks()
+void LevelScene::layoutBlocks()
 {
-    // Clear existing blocks
-    mGameObjects.erase
-    (
-        std::remove_if(mGameObjects.begin(), mGameObjects.end(),
-            [](const std::unique_ptr<GameObject>& obj) {
-                return dynamic_cast<Block*>(obj.get()) != nullptr;
-            }),
-        mGameObjects.end());
-
-    // Create blocks based on current level
+    // Authored block positions for the current level
+    const sf::Vector2f blockSize(80.f, 80.f);
     switch (mCurrentLevel)
     {
     case 1:
         // Level 1 block layout
         for (int i = 0; i < 5; ++i)
         {
-            auto block = std::make_unique<Block>(mBlockTexture, 80.f, 80.f);
             float xPos = 1500.f + i * 90.f;
             float yPos = 800.f - i * 90.f;
-            block->setPosition(xPos, yPos);
-            block->initPhysicsBody(mPhysicsWorld);
-            mGameObjects.push_back(std::move(block));
+            mInitialState.push_back({ ObjectSpawn::Kind::Block, sf::Vector2f(xPos, yPos), 0.f, blockSize });
         }
         break;
     case 2:
         // Level 2 block layout
         for (int i = 0; i < 7; ++i)
         {
-            auto block = std::make_unique<Block>(mBlockTexture, 80.f, 80.f);
             float xPos = 1400.f + i * 80.f;
             float yPos = 800.f - std::abs(3 - i) * 80.f;
-            block->setPosition(xPos, yPos);
-            block->initPhysicsBody(mPhysicsWorld);
-            mGameObjects.push_back(std::move(block));
+            mInitialState.push_back({ ObjectSpawn::Kind::Block, sf::Vector2f(xPos, yPos), 0.f, blockSize });
         }
         break;
     case 3:
         // Level 3 block layout
         for (int i = 0; i < 9; ++i)
         {
-            auto block = std::make_unique<Block>(mBlockTexture, 80.f, 80.f);
             float xPos = 1300.f + (i % 3) * 90.f;
             float yPos = 800.f - (i / 3) * 90.f;
-            block->setPosition(xPos, yPos);
-            block->initPhysicsBody(mPhysicsWorld);
-            mGameObjects.push_back(std::move(block));
+            mInitialState.push_back({ ObjectSpawn::Kind::Block, sf::Vector2f(xPos, yPos), 0.f, blockSize });
         }
         break;
     default:
@@ -610,21 +745,22 @@ void LevelScene::updateUI(int projectilesLeft, int enemiesLeft, int currentLevel
 
 void LevelScene::removeDestroyedObjects()
 {
-    auto windowSize = mWindow->getSize();
-    mGameObjects.erase(
-        std::remove_if(mGameObjects.begin(), mGameObjects.end(),
-            [this, windowSize](const std::unique_ptr<GameObject>& obj) 
-            {
-                if (obj->isMarkedForDeletion() ||
-                    obj->getPosition().x < 0 || obj->getPosition().x > windowSize.x ||
-                    obj->getPosition().y < 0 || obj->getPosition().y > windowSize.y)
-                {
-                    mPhysicsWorld.destroyBody(obj->getPhysicsBody());
-                    return true;
-                }
-                return false;
-            }),
-        mGameObjects.end());
+    // A body that did not move in the last step cannot have left the world since then
+    bool leftWorld = false;
+    for (GameObject* object : mPhysicsWorld.getObjectsToUpdate())
+    {
+        b2Body* body = object->getPhysicsBody();
+        if (isUpdatedByScene(*object) && body && mPhysicsWorld.isOutsideWorldBounds(body->GetPosition()))
+        {
+            object->markForDeletion();
+            leftWorld = true;
+        }
+    }
+
+    if (leftWorld)
+    {
+        removeMarkedObjects();
+    }
 }
 
 void LevelScene::addProjectile(std::unique_ptr<Projectile> projectile)
@@ -648,14 +784,10 @@ bool LevelScene::checkCollision(GameObject* obj1, GameObject* obj2)
     return false;
 }
 
-bool LevelScene::isProjectileOffScreen(const std::unique_ptr<Projectile>& projectile) const
+bool LevelScene::isProjectileOutOfBounds(const std::unique_ptr<Projectile>& projectile) const
 {
-    sf::Vector2f position = projectile->getPosition();
-    sf::Vector2u windowSize = mWindow->getSize();
-    float buffer = 100.0f; // Allow some buffer off-screen
-
-    return position.x < -buffer || position.x > windowSize.x + buffer ||
-        position.y < -buffer || position.y > windowSize.y + buffer;
+    b2Body* body = projectile->getPhysicsBody();
+    return body && mPhysicsWorld.isOutsideWorldBounds(body->GetPosition());
 }
 
 void LevelScene::updateProjectileType()
@@ -680,15 +812,29 @@ void LevelScene::setLevel(int level)
     mProjectilesLeft = MAX_PROJECTILES;
     mEnemiesLeft = 0;
     mFinalProjectileLaunched = false;
+    mProjectileLaunched = false;
+    mQuiescentTime = sf::Time::Zero;
+    mIsDragging = false;
+    mTrajectoryPoints.clear();
+    mTrajectoryPredictor.invalidate();
+    mPendingActions.clear();
 
-    // Clear existing objects
+    // Objects go before the world so none of them is left holding a destroyed body,
+    // then every body from the previous attempt goes in one step
     mGameObjects.clear();
     mProjectiles.clear();
+    mDebrisPool.release();
+    mPhysicsWorld.clear();
 
-    // Recreate level elements
+    configureWorldBounds();
     createGround();
-    createBlocks();
-    createEnemies();
+    mDebrisPool.initialize(mPhysicsWorld, mBlockTexture.get());
+
+    if (mInitialStateLevel != level)
+    {
+        loadInitialState();
+    }
+    spawnInitialState();
 
     // Reset projectile availability
     resetProjectileAvailability();
@@ -696,6 +842,189 @@ void LevelScene::setLevel(int level)
     updateUI(mProjectilesLeft, mEnemiesLeft, mCurrentLevel);
 }
 
+void LevelScene::loadInitialState()
+{
+    mInitialState.clear();
+    mInitialStateSettled = mUseBakedLayout && loadBakedLayout();
+    if (!mInitialStateSettled)
+    {
+        layoutBlocks();
+        layoutEnemies();
+    }
+
+    mInitialStateLevel = mCurrentLevel;
+    mInitialBodyCount = 0;
+}
+
+bool LevelScene::loadBakedLayout()
+{
+    // Read through the asset archive when it has the file, otherwise from disk
+    std::string contents;
+    const void* data = nullptr;
+    std::size_t size = 0;
+    if (AssetCache::getInstance().findInArchive(BAKED_LAYOUT_PATH, data, size))
+    {
+        contents.assign(static_cast<const char*>(data), size);
+    }
+    else
+    {
+        std::ifstream file(BAKED_LAYOUT_PATH);
+        if (!file)
+        {
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::istringstream input(contents);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        // level kind x y rotation width height [category mask]
+        std::istringstream fields(line);
+        int level = 0;
+        std::string kind;
+        ObjectSpawn spawn = {};
+        if (!(fields >> level >> kind >> spawn.position.x >> spawn.position.y >> spawn.rotation >> spawn.size.x >> spawn.size.y))
+        {
+            std::cout << "Ignoring malformed line in " << BAKED_LAYOUT_PATH << ": " << line << std::endl;
+            continue;
+        }
+
+        // Optional hexadecimal filter bits, used in place of CollisionFilter::forKind
+        unsigned int category = 0;
+        unsigned int mask = 0;
+        if (fields >> std::hex >> category >> mask)
+        {
+            spawn.hasFilter = true;
+            spawn.filter.categoryBits = static_cast<uint16>(category);
+            spawn.filter.maskBits = static_cast<uint16>(mask);
+        }
+
+        if (level == mCurrentLevel)
+        {
+            spawn.kind = kind == "enemy" ? ObjectSpawn::Kind::Enemy : ObjectSpawn::Kind::Block;
+            mInitialState.push_back(spawn);
+        }
+    }
+
+    return !mInitialState.empty();
+}
+
+void LevelScene::spawnInitialState()
+{
+    mGameObjects.reserve(mInitialState.size());
+    mEnemiesLeft = 0;
+
+    for (const ObjectSpawn& spawn : mInitialState)
+    {
+        std::unique_ptr<GameObject> object;
+        if (spawn.kind == ObjectSpawn::Kind::Block)
+        {
+            auto block = std::make_unique<Block>(*mBlockTexture, spawn.size.x, spawn.size.y);
+            block->setPosition(spawn.position.x, spawn.position.y);
+            block->initPhysicsBody(mPhysicsWorld);
+            object = std::move(block);
+        }
+        else
+        {
+            auto enemy = std::make_unique<Enemy>(*mEnemyTexture, spawn.size.x, spawn.size.y);
+            enemy->setPosition(spawn.position.x, spawn.position.y);
+            enemy->initPhysicsBody(mPhysicsWorld);
+            object = std::move(enemy);
+            mEnemiesLeft++;
+        }
+
+        if (spawn.hasFilter)
+        {
+            object->setCollisionFilter(spawn.filter);
+        }
+        object->setRotation(spawn.rotation);
+        b2Body* body = object->getPhysicsBody();
+        body->SetTransform(body->GetPosition(), spawn.rotation * b2_pi / 180.f);
+
+        // Baked layouts are already at rest, so nothing needs simulating until something hits them
+        if (mInitialStateSettled)
+        {
+            body->SetAwake(false);
+        }
+        mGameObjects.push_back(std::move(object));
+    }
+
+    mCountedObjectCount = mGameObjects.size();
+
+    // The first spawn sets the expected count, every restart must match it
+    if (mInitialBodyCount == 0)
+    {
+        mInitialBodyCount = mPhysicsWorld.getBodyCount();
+    }
+    else if (mPhysicsWorld.getBodyCount() != mInitialBodyCount)
+    {
+        std::cout << "Level " << mCurrentLevel << " restarted with " << mPhysicsWorld.getBodyCount()
+            << " bodies, expected " << mInitialBodyCount << std::endl;
+    }
+}
+
+bool LevelScene::settle(int maxSteps)
+{
+    // Settle at the default solver quality, however many bodies fall at once
+    mPhysicsWorld.getSolverController().setAdaptive(false);
+
+    const float timeStep = 1.f / 60.f;
+    for (int step = 0; step < maxSteps; ++step)
+    {
+        mPhysicsWorld.update(timeStep);
+
+        if (mPhysicsWorld.getAwakeBodyCount() == 0)
+        {
+            std::cout << "Level " << mCurrentLevel << " settled after " << step + 1 << " steps" << std::endl;
+            return true;
+        }
+    }
+
+    std::cout << "Level " << mCurrentLevel << " did not settle within " << maxSteps << " steps" << std::endl;
+    return false;
+}
+
+void LevelScene::writeSettledLayout(std::ostream& output) const
+{
+    for (const auto& object : mGameObjects)
+    {
+        b2Body* body = object->getPhysicsBody();
+        bool isEnemy = dynamic_cast<Enemy*>(object.get()) != nullptr;
+        if (!body || (!isEnemy && !dynamic_cast<Block*>(object.get())))
+        {
+            continue;
+        }
+
+        // Objects that fell out of the level during the bake are left out
+        if (mPhysicsWorld.isOutsideWorldBounds(body->GetPosition()))
+        {
+            continue;
+        }
+
+        const sf::Sprite& sprite = object->getSprite();
+        output << mCurrentLevel << ' ' << (isEnemy ? "enemy" : "block") << ' '
+            << body->GetPosition().x * PhysicsWorld::SCALE << ' '
+            << body->GetPosition().y * PhysicsWorld::SCALE << ' '
+            << body->GetAngle() * 180.f / b2_pi << ' '
+            << sprite.getLocalBounds().width * sprite.getScale().x << ' '
+            << sprite.getLocalBounds().height * sprite.getScale().y;
+        if (object->hasCollisionFilterOverride())
+        {
+            b2Filter filter = object->getCollisionFilter();
+            output << std::hex << std::showbase << ' ' << filter.categoryBits << ' ' << filter.maskBits
+                << std::dec << std::noshowbase;
+        }
+        output << '\n';
+    }
+}
+
 void LevelScene::resetProjectileAvailability()
 {
     for (int i = 0; i < 5; ++i) 
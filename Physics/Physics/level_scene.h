@@ -3,25 +3,32 @@
 
 #include "scene.h"
 #include "projectile.h"
+#include "trajectory_predictor.h"
+#include "debris_pool.h"
 #include <SFML/Graphics.hpp>
 #include <Box2D/Box2D.h>
 #include <vector>
 #include <array>
+#include <memory>
+#include <ostream>
 
 class LevelScene : public Scene
 {
 public:
-    LevelScene();
+    explicit LevelScene(int level = 1);
+
+    // Only needs cached textures and touches nothing outside the scene, so a scene for
+    // an upcoming level can be initialized on a worker thread
     void initialize() override;
     void handleEvent(const sf::Event& event) override;
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow& window) override;
+    void updateFrame(sf::Time deltaTime) override;
+    void render(RenderSnapshot& snapshot) override;
     std::unique_ptr<sf::RectangleShape> mGroundShape;
 
     void addProjectile(std::unique_ptr<Projectile> projectile);
     bool checkCollision(GameObject* obj1, GameObject* obj2);
-    bool isProjectileOffScreen(const std::unique_ptr<Projectile>& projectile) const;
-    sf::Font mDebugFont;
+    bool isProjectileOutOfBounds(const std::unique_ptr<Projectile>& projectile) const;
 
     bool isLevelCompleted() const { return mLevelCompleted; }
     bool isLevelFailed() const { return mLevelFailed; }
@@ -29,13 +36,33 @@ public:
     void setLevel(int level);
     int getCurrentLevel() const { return mCurrentLevel; }
 
+    // Every texture initialize() expects to find in the AssetCache
+    static const std::vector<std::string>& getRequiredTextures();
+
     void resetProjectileAvailability();
+    void setSpeedLabel(const std::string& label) { mGameUI.setSpeedLabel(label); }
+
+    // Offline bake: start from the authored layout, simulate until every body sleeps and
+    // write the resting transforms as lines of "level kind x y rotation width height"
+    void setUseBakedLayout(bool useBaked) { mUseBakedLayout = useBaked; }
+    bool settle(int maxSteps);
+    void writeSettledLayout(std::ostream& output) const;
+
+    static const char* const BAKED_LAYOUT_PATH;
 
 private:
+    void configureWorldBounds();
+    void updateCamera();
     void createGround();
     void resetProjectile();
-    void createBlocks();
-    void createEnemies();
+    void layoutBlocks();
+    void layoutEnemies();
+
+    // Every start and restart of a level spawns its objects from the same initial state,
+    // taken from the baked layout when there is one and from the authored layout otherwise
+    void loadInitialState();
+    bool loadBakedLayout();
+    void spawnInitialState();
     
     void checkLevelCompletion();
     bool mLevelCompleted;
@@ -45,20 +72,21 @@ private:
     void updateTrajectory();
     void createProjectile();
     void launchProjectile();
+    bool computeLaunch(const sf::Vector2f& pull, sf::Vector2f& direction, float& force) const;
     void updateUI(int projectilesLeft, int enemiesLeft, int currentLevel);
     void loadProjectileTextures();
     void updateProjectileType();
 
-    sf::Texture mBackgroundTexture;
+    std::shared_ptr<const sf::Texture> mBackgroundTexture;
     sf::Sprite mBackgroundSprite;
-    sf::Texture mGroundTexture;
+    std::shared_ptr<const sf::Texture> mGroundTexture;
     sf::Sprite mGroundSprite;
-    sf::Texture mBlockTexture;
-    sf::Texture mEnemyTexture;
-    sf::Texture mFireballTexture;
+    std::shared_ptr<const sf::Texture> mBlockTexture;
+    std::shared_ptr<const sf::Texture> mEnemyTexture;
+    std::shared_ptr<const sf::Texture> mFireballTexture;
     sf::Sprite mFireballSprite;
 
-    std::array<sf::Texture, 5> mProjectileTextures;
+    std::array<std::shared_ptr<const sf::Texture>, 5> mProjectileTextures;
     std::vector<std::unique_ptr<Projectile>> mProjectiles;
 
     sf::Vector2f mSlingshotPos;
@@ -71,28 +99,61 @@ private:
     const float PROJECTILE_RADIUS = 30.f;
 
     std::vector<sf::Vector2f> mTrajectoryPoints;
+    TrajectoryPredictor mTrajectoryPredictor; // Rebuilt on the first drag after the level moved
+    unsigned int mTrajectoryAwakeSetChanges; // PhysicsWorld::getAwakeSetChanges() when it was last rebuilt
+    DebrisPool mDebrisPool; // Fragments of destroyed blocks, bodies recreated with each world
     const int NUM_POINTS = 30;
     const float TIME_STEP_TRAJECTORY = 0.1f;
+    const float PULL_QUANTUM = 2.f; // Pixels of pull that share one previewed path
 
     bool mDebugDraw;
 
+    // World size in metres, independent of the window
+    float mWorldWidth;
+    float mWorldHeight;
+    const float WORLD_HEADROOM = 36.f; // Metres above the level before objects are lost
+    sf::Vector2f mCameraHome;
+
     // Constants for positioning
     const float GROUND_HEIGHT = 100.f;
     const float SLINGSHOT_WIDTH = 20.f;
     const float SLINGSHOT_HEIGHT = 200.f;
 
     bool mProjectileLaunched;
-    sf::Clock mProjectileLifetime;
-    const float PROJECTILE_LIFETIME = 8.0f; // 8 seconds
+
+    // A shot is over once the world has been quiet for a while, rather than when the
+    // projectile's lifetime runs out or it leaves the level
+    void endShot();
+    sf::Time mQuiescentTime;
+    const float QUIESCENT_ENERGY = 0.02f; // Kinetic energy per kilogram, about 0.2 m/s
+    const sf::Time QUIESCENT_TIME = sf::seconds(0.5f);
 
     const int MAX_PROJECTILES = 5;
     int mProjectilesLeft;
     int mEnemiesLeft;
+    std::size_t mCountedObjectCount; // Size of mGameObjects when mEnemiesLeft was counted
     int mCurrentLevel;
     bool mFinalProjectileLaunched;
 
     void removeDestroyedObjects();
     std::vector<std::function<void()>> mPendingActions;
+
+    struct ObjectSpawn
+    {
+        enum class Kind { Block, Enemy };
+        Kind kind;
+        sf::Vector2f position; // Pixels
+        float rotation;        // Degrees
+        sf::Vector2f size;
+        bool hasFilter;        // Category and mask given by the level instead of by kind
+        b2Filter filter;
+    };
+
+    std::vector<ObjectSpawn> mInitialState;
+    int mInitialStateLevel;        // Level the initial state belongs to, 0 when none
+    int mInitialBodyCount;         // Bodies in the world right after the level is set up
+    bool mInitialStateSettled;     // Baked, objects start asleep
+    bool mUseBakedLayout;
 };
 
 #endif
\ No newline at end of file
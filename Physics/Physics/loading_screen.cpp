@@ -0,0 +1,54 @@
+#include "loading_screen.h"
+
+const sf::Vector2f LoadingScreen::BAR_SIZE(600.f, 24.f);
+
+LoadingScreen::LoadingScreen(sf::RenderWindow& window)
+    : Menu(window), mProgress(0.f), mDotTimer(0.f), mDotCount(0)
+{
+    mTitle.setAtlas(*mGlyphs);
+    mTitle.setString("Loading");
+    mTitle.setCharacterSize(50);
+    mTitle.setFillColor(sf::Color::Black);
+    mTitle.setPosition(mWindow.getSize().x / 2.f - mTitle.getLocalBounds().width / 2.f, mWindow.getSize().y / 2.f - 100.f);
+
+    sf::Vector2f barPosition(mWindow.getSize().x / 2.f - BAR_SIZE.x / 2.f, mWindow.getSize().y / 2.f);
+    mBarBackground.setSize(BAR_SIZE);
+    mBarBackground.setPosition(barPosition);
+    mBarBackground.setFillColor(sf::Color(200, 200, 200));
+
+    mBar.setSize(sf::Vector2f(0.f, BAR_SIZE.y));
+    mBar.setPosition(barPosition);
+    mBar.setFillColor(sf::Color(60, 140, 60));
+}
+
+void LoadingScreen::handleEvent(const sf::Event& event)
+{
+}
+
+void LoadingScreen::update(sf::Time deltaTime)
+{
+    // Animated dots show the game has not hung even when the bar does not move
+    mDotTimer += deltaTime.asSeconds();
+    if (mDotTimer >= 0.3f)
+    {
+        mDotTimer = 0.f;
+        mDotCount = (mDotCount + 1) % 4;
+        mTitle.setString("Loading" + std::string(mDotCount, '.'));
+    }
+}
+
+void LoadingScreen::render(RenderSnapshot& snapshot)
+{
+    snapshot.draw(mBarBackground);
+    snapshot.draw(mBar);
+
+    mTextBatch.clear();
+    mTextBatch.add(mTitle);
+    mTextBatch.draw(snapshot);
+}
+
+void LoadingScreen::setProgress(float progress)
+{
+    mProgress = progress;
+    mBar.setSize(sf::Vector2f(BAR_SIZE.x * mProgress, BAR_SIZE.y));
+}
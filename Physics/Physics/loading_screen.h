@@ -0,0 +1,31 @@
+#ifndef LOADING_SCREEN_H
+#define LOADING_SCREEN_H
+
+#include "menu.h"
+
+// Shown while the AssetLoader works through its queue. Only uses the font, so it is
+// available before any texture has been decoded.
+class LoadingScreen : public Menu
+{
+public:
+    LoadingScreen(sf::RenderWindow& window);
+
+    void handleEvent(const sf::Event& event) override;
+    void update(sf::Time deltaTime) override;
+    void render(RenderSnapshot& snapshot) override;
+    bool isAnimating() const override { return true; }
+
+    void setProgress(float progress);
+
+private:
+    BitmapText mTitle;
+    sf::RectangleShape mBarBackground;
+    sf::RectangleShape mBar;
+    float mProgress;
+    float mDotTimer;
+    int mDotCount;
+
+    static const sf::Vector2f BAR_SIZE;
+};
+
+#endif
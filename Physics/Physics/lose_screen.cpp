@@ -1,20 +1,25 @@
 #include "lose_screen.h"
 #include "game.h"
+#include "asset_cache.h"
 #include <iostream>
 
 LoseScreen::LoseScreen(sf::RenderWindow& window, Game& game)
     : Menu(window), mGame(game)
 {
-    if (!mBackgroundTexture.loadFromFile("dependencies/sprites/lose.png"))
+    mBackgroundTexture = AssetCache::getInstance().getTexture("dependencies/sprites/lose.png");
+    if (!mBackgroundTexture)
     {
         std::cout << "Failed to load lose screen background image" << std::endl;
     }
-    mBackgroundSprite.setTexture(mBackgroundTexture);
+    else
+    {
+        mBackgroundSprite.setTexture(*mBackgroundTexture);
 
-    // Scale the background to fit the window
-    float scaleX = window.getSize().x / static_cast<float>(mBackgroundTexture.getSize().x);
-    float scaleY = window.getSize().y / static_cast<float>(mBackgroundTexture.getSize().y);
-    mBackgroundSprite.setScale(scaleX, scaleY);
+        // Scale the background to fit the window
+        float scaleX = window.getSize().x / static_cast<float>(mBackgroundTexture->getSize().x);
+        float scaleY = window.getSize().y / static_cast<float>(mBackgroundTexture->getSize().y);
+        mBackgroundSprite.setScale(scaleX, scaleY);
+    }
 
     addButton("Try Again", [this]() { mGame.restartLevel(); });
     addButton("Main Menu", [this]() { mGame.setState(Game::GameState::MainMenu); });
@@ -32,7 +37,7 @@ void LoseScreen::handleEvent(const sf::Event& event)
 {
     if (event.type == sf::Event::MouseButtonPressed) 
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         for (auto& button : mButtons) 
         {
             if (button.text.getGlobalBounds().contains(mousePos)) 
@@ -48,11 +53,14 @@ void LoseScreen::update(sf::Time deltaTime)
 {
 }
 
-void LoseScreen::render() 
+void LoseScreen::render(RenderSnapshot& snapshot) 
 {
-    mWindow.draw(mBackgroundSprite);
+    snapshot.draw(mBackgroundSprite);
+
+    mTextBatch.clear();
     for (const auto& button : mButtons)
     {
-        mWindow.draw(button.text);
+        mTextBatch.add(button.text);
     }
+    mTextBatch.draw(snapshot);
 }
\ No newline at end of file
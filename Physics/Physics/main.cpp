@@ -1,23 +1,114 @@
 #include "game.h"
 #include "level_scene.h"
+#include "asset_cache.h"
+#include "asset_archive.h"
+#include "startup_profiler.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
-int main() 
+// Packs the loose files the game loads into one archive, also the last part of baking
+int packAssets()
 {
+    // Everything the game loads, listed by the code that loads it, each file once
+    std::vector<std::string> packed = Menu::getRequiredTextures();
+    const std::vector<std::string>& levelTextures = LevelScene::getRequiredTextures();
+    packed.insert(packed.end(), levelTextures.begin(), levelTextures.end());
+    packed.push_back(GlyphAtlas::DEFAULT_FONT_PATH);
+    std::sort(packed.begin(), packed.end());
+    packed.erase(std::unique(packed.begin(), packed.end()), packed.end());
+
+    // Only exists once the levels have been baked
+    if (std::ifstream(LevelScene::BAKED_LAYOUT_PATH))
+    {
+        packed.push_back(LevelScene::BAKED_LAYOUT_PATH);
+    }
+
+    return AssetArchive::pack(packed, AssetArchive::DEFAULT_PATH) ? 0 : 1;
+}
+
+// Build step, run after every build: lets every level fall into place with the solver
+// settings the game settles them with, and stores where everything came to rest, so levels
+// start settled and asleep. The archive is packed again afterwards.
+int bakeLevels()
+{
+    const int LEVEL_COUNT = 3;
+    const int MAX_SETTLE_STEPS = 60 * 60;
+
+    // Levels load their textures on creation, which needs a GL context
+    sf::RenderWindow window(sf::VideoMode(1920, 1080), "Baking levels", sf::Style::None);
+    window.setVisible(false);
+
+    std::ostringstream output;
+    output << "# Generated by --bake-levels: level kind x y rotation width height [category mask]\n";
+
+    for (int level = 1; level <= LEVEL_COUNT; ++level)
+    {
+        LevelScene scene(level);
+        scene.setUseBakedLayout(false);
+        scene.setWindow(&window);
+        scene.initialize();
+        if (!scene.settle(MAX_SETTLE_STEPS))
+        {
+            return 1;
+        }
+        scene.writeSettledLayout(output);
+    }
+
+    std::ofstream file(LevelScene::BAKED_LAYOUT_PATH, std::ios::trunc);
+    file << output.str();
+    if (!file)
+    {
+        std::cout << "Failed to write " << LevelScene::BAKED_LAYOUT_PATH << std::endl;
+        return 1;
+    }
+
+    std::cout << "Baked " << LEVEL_COUNT << " levels into " << LevelScene::BAKED_LAYOUT_PATH << std::endl;
+    AssetCache::getInstance().clear();
+
+    // The game reads the layout from the archive first, so it has to carry the new one
+    return packAssets();
+}
+
+int main(int argc, char* argv[]) 
+{
+    if (argc > 1 && std::strcmp(argv[1], "--pack-assets") == 0)
+    {
+        return packAssets();
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bake-levels") == 0)
+    {
+        return bakeLevels();
+    }
+
+    // Starts the startup clock
+    StartupProfiler& profiler = StartupProfiler::getInstance();
+
+    // One mapped file instead of a file open per asset, loose files are used when it is missing
+    AssetCache::getInstance().mountArchive(AssetArchive::DEFAULT_PATH);
+    profiler.markPhase("Mount asset archive");
+
     // Create SFML window
     sf::RenderWindow window(sf::VideoMode(1920, 1080), "Angry Birds Clone", sf::Style::Fullscreen);
-    window.setFramerateLimit(60);
+    // Pace frames to the display, the game loop interpolates between fixed physics steps
+    window.setVerticalSyncEnabled(true);
+    profiler.markPhase("Create window");
 
-    // Create and initialize the game
-    Game game;
-    game.setWindow(&window);
+    {
+        // Create and initialize the game, the level is only built once it is first played
+        Game game;
+        game.setWindow(&window);
+        profiler.markPhase("Set up game");
 
-    // Create and set the initial scene
-    auto levelOneScene = std::make_unique<LevelScene>();
-    game.setScene(std::move(levelOneScene));
+        // Run the game
+        game.run();
+    }
 
-    // Run the game
-    game.run();
+    // Anything still in use was released along with the game
+    AssetCache::getInstance().clear();
 
     return 0;
-}
\ No newline at end of file
+}
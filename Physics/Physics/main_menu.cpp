@@ -1,4 +1,5 @@
 #include "main_menu.h"
+#include "asset_cache.h"
 #include <iostream>
 
 MainMenu::MainMenu(sf::RenderWindow& window)
@@ -15,19 +16,23 @@ MainMenu::MainMenu(sf::RenderWindow& window, std::function<void(int)> callback)
 
 void MainMenu::initialize()
 {
-    if (!mBackgroundTexture.loadFromFile("dependencies/sprites/menu.png")) 
+    mBackgroundTexture = AssetCache::getInstance().getTexture("dependencies/sprites/menu.png");
+    if (!mBackgroundTexture)
     {
         std::cout << "Failed to load menu background image" << std::endl;
     }
-    mBackgroundSprite.setTexture(mBackgroundTexture);
+    else
+    {
+        mBackgroundSprite.setTexture(*mBackgroundTexture);
 
-    // Scale the background to fit the window
-    float scaleX = mWindow.getSize().x / static_cast<float>(mBackgroundTexture.getSize().x);
-    float scaleY = mWindow.getSize().y / static_cast<float>(mBackgroundTexture.getSize().y);
-    mBackgroundSprite.setScale(scaleX, scaleY);
+        // Scale the background to fit the window
+        float scaleX = mWindow.getSize().x / static_cast<float>(mBackgroundTexture->getSize().x);
+        float scaleY = mWindow.getSize().y / static_cast<float>(mBackgroundTexture->getSize().y);
+        mBackgroundSprite.setScale(scaleX, scaleY);
+    }
 
     // Set up title text
-    mTitleText.setFont(mFont);
+    mTitleText.setAtlas(*mGlyphs);
     mTitleText.setString("Angry Birds Remake");
     mTitleText.setCharacterSize(60);
     mTitleText.setFillColor(sf::Color::White);
@@ -50,12 +55,12 @@ void MainMenu::handleEvent(const sf::Event& event)
 {
     if (event.type == sf::Event::MouseMoved)
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         updateButtonHover(mousePos);
     }
     if (event.type == sf::Event::MouseButtonPressed) 
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         for (size_t i = 0; i < mButtons.size(); ++i) 
         {
             if (mButtons[i].hitbox.contains(mousePos))
@@ -71,12 +76,15 @@ void MainMenu::update(sf::Time deltaTime)
 {
 }
 
-void MainMenu::render()
+void MainMenu::render(RenderSnapshot& snapshot)
 {
-    mWindow.draw(mBackgroundSprite);
-    mWindow.draw(mTitleText);
+    snapshot.draw(mBackgroundSprite);
+
+    mTextBatch.clear();
+    mTextBatch.add(mTitleText);
     for (const auto& button : mButtons)
     {
-        mWindow.draw(button.text);
+        mTextBatch.add(button.text);
     }
+    mTextBatch.draw(snapshot);
 }
\ No newline at end of file
@@ -12,13 +12,13 @@ public:
 
     void handleEvent(const sf::Event& event) override;
     void update(sf::Time deltaTime) override;
-    void render() override;
+    void render(RenderSnapshot& snapshot) override;
 
 private:
     void initialize();
     sf::Sprite mBackgroundSprite;
-    sf::Texture mBackgroundTexture;
-    sf::Text mTitleText;
+    std::shared_ptr<const sf::Texture> mBackgroundTexture;
+    BitmapText mTitleText;
     std::function<void(int)> mCallback;
 };
 
@@ -1,18 +1,31 @@
 #include "menu.h"
+#include "asset_cache.h"
 #include <iostream>
 
-Menu::Menu(sf::RenderWindow& window) : mWindow(window)
+Menu::Menu(sf::RenderWindow& window)
+    : mWindow(window), mGlyphs(AssetCache::getInstance().getGlyphAtlas(GlyphAtlas::DEFAULT_FONT_PATH))
 {
-    if (!mFont.loadFromFile("dependencies/font.ttf")) 
+    if (!mGlyphs) 
     {
         std::cout << "failed to load menu font \n";
+        mGlyphs = std::make_shared<GlyphAtlas>();
     }
 }
 
+const std::vector<std::string>& Menu::getRequiredTextures()
+{
+    static const std::vector<std::string> textures = {
+        "dependencies/sprites/menu.png",
+        "dependencies/sprites/win.png",
+        "dependencies/sprites/lose.png"
+    };
+    return textures;
+}
+
 void Menu::addButton(const std::string& text, const std::function<void()>& action) 
 {
     Button button;
-    button.text.setFont(mFont);
+    button.text.setAtlas(*mGlyphs);
     button.text.setString(text);
     button.text.setCharacterSize(30);
     button.action = action;
@@ -20,7 +33,7 @@ void Menu::addButton(const std::string& text, const std::function<void()>& actio
     mButtons.push_back(button);
 }
 
-void Menu::centerText(sf::Text& text, float yPosition) 
+void Menu::centerText(BitmapText& text, float yPosition) 
 {
     sf::FloatRect textRect = text.getLocalBounds();
     text.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
@@ -45,6 +58,17 @@ void Menu::centerText(sf::Text& text, float yPosition)
     }
 }
 
+void Menu::activate()
+{
+    // Do not show a button highlighted from the last time the menu was open
+    for (auto& button : mButtons)
+    {
+        button.isHovered = false;
+        button.text.setFillColor(sf::Color::White);
+        button.text.setScale(1.0f, 1.0f);
+    }
+}
+
 void Menu::updateButtonHover(const sf::Vector2f& mousePos) 
 {
     for (auto& button : mButtons)
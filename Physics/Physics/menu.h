@@ -4,6 +4,10 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <functional>
+#include <memory>
+#include "render_snapshot.h"
+#include "bitmap_text.h"
+#include "text_batch.h"
 
 class Menu
 {
@@ -13,15 +17,25 @@ public:
 
     virtual void handleEvent(const sf::Event& event) = 0;
     virtual void update(sf::Time deltaTime) = 0;
-    virtual void render() = 0;
+    virtual void render(RenderSnapshot& snapshot) = 0;
+
+    // Menus are kept alive between uses, called each time one is shown again
+    virtual void activate();
+
+    // Menus that change on their own need regular frames, the rest only redraw after input
+    virtual bool isAnimating() const { return false; }
+
+    // Every texture the menu screens expect to find in the AssetCache
+    static const std::vector<std::string>& getRequiredTextures();
 
 protected:
     sf::RenderWindow& mWindow;
-    sf::Font mFont;
+    std::shared_ptr<const GlyphAtlas> mGlyphs;
+    TextBatch mTextBatch; // All of a menu's text goes out in one draw
 
     struct Button
     {
-        sf::Text text;
+        BitmapText text;
         sf::FloatRect hitbox;
         std::function<void()> action;
         bool isHovered;
@@ -30,7 +44,7 @@ protected:
     std::vector<Button> mButtons;
 
     void addButton(const std::string& text, const std::function<void()>& action);
-    void centerText(sf::Text& text, float yPosition);
+    void centerText(BitmapText& text, float yPosition);
     void updateButtonHover(const sf::Vector2f& mousePos);
 };
 
@@ -27,12 +27,12 @@ void PauseMenu::handleEvent(const sf::Event& event)
 {
     if (event.type == sf::Event::MouseMoved)
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         updateButtonHover(mousePos);
     }
     if (event.type == sf::Event::MouseButtonPressed)
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         for (size_t i = 0; i < mButtons.size(); ++i)
         {
             if (mButtons[i].hitbox.contains(mousePos))
@@ -48,11 +48,14 @@ void PauseMenu::update(sf::Time deltaTime)
 {
 }
 
-void PauseMenu::render()
+void PauseMenu::render(RenderSnapshot& snapshot)
 {
-    mWindow.draw(mOverlay);
+    snapshot.draw(mOverlay);
+
+    mTextBatch.clear();
     for (const auto& button : mButtons) 
     {
-        mWindow.draw(button.text);
+        mTextBatch.add(button.text);
     }
+    mTextBatch.draw(snapshot);
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ public:
 
     void handleEvent(const sf::Event& event) override;
     void update(sf::Time deltaTime) override;
-    void render() override;
+    void render(RenderSnapshot& snapshot) override;
 
 private:
     void initialize();
@@ -5,30 +5,273 @@
 #include "block.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
-PhysicsWorld::PhysicsWorld()
-    : mWorld(std::make_unique<b2World>(b2Vec2(0, 9.81f))), mWindow(nullptr)
+PhysicsWorld::PhysicsWorld() : mWindow(nullptr), mAwakeBodyCount(0), mMaxKineticEnergy(0.f), mRemovedBodyCount(0), mAwakeSetChanges(0)
 {
+    createWorld(b2Vec2(0, 9.81f));
+
+    mWorldBounds.lowerBound.Set(0.f, 0.f);
+    mWorldBounds.upperBound.Set(DEFAULT_WORLD_WIDTH, DEFAULT_WORLD_HEIGHT);
+}
+
+PhysicsWorld::~PhysicsWorld() = default;
+
+void PhysicsWorld::createWorld(const b2Vec2& gravity)
+{
+    mWorld = std::make_unique<b2World>(gravity);
     mWorld->SetContactListener(this);
     mWorld->SetAutoClearForces(false);
+    // Everything is swept against static geometry, sweeps between dynamic bodies are
+    // switched per body by the CcdManager
     mWorld->SetContinuousPhysics(true);
-    mWorld->SetSubStepping(true);
 }
 
-PhysicsWorld::~PhysicsWorld() = default;
+void PhysicsWorld::clear()
+{
+    mGameObjects.clear();
+    createWorld(mWorld->GetGravity());
+    mSolverController.reset();
+    mAwakeBodyCount = 0;
+    mMaxKineticEnergy = 0.f;
+    mAwakeBodies.clear();
+    mAwakeBodySet.clear();
+    mFallenAsleep.clear();
+    mObjectsToUpdate.clear();
+    mRemovedBodyCount = 0;
+}
 
 void PhysicsWorld::update(float deltaTime)
 {
-    mWorld->Step(deltaTime, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    if (mAwakeBodyCount == 0)
+    {
+        // Nothing moves until something wakes a body, so stepping a sleeping world would
+        // change nothing. The tracked bodies are checked again in case one was woken or added.
+        mAwakeBodyCount = updateSleepStates();
+        if (mAwakeBodyCount == 0)
+        {
+            mWorld->ClearForces();
+            removeMarkedBodies();
+            cleanupMarkedObjects();
+            return;
+        }
+    }
+
+    // Forces are kept across sub-steps and cleared once the whole step is done
+    const SolverController::Settings& settings = mSolverController.getSettings();
+    int subSteps = settings.subSteps;
+    float subStepTime = deltaTime / subSteps;
+    float solveTime = 0.f;
+    prepareAwakeBodies(subStepTime);
+    for (int i = 0; i < subSteps; ++i)
+    {
+        mWorld->Step(subStepTime, settings.velocityIterations, settings.positionIterations);
+        solveTime += mWorld->GetProfile().solve;
+    }
     mWorld->ClearForces();
+    mAwakeBodyCount = updateSleepStates();
+    mSolverController.record(solveTime, mAwakeBodyCount);
     removeMarkedBodies();
     cleanupMarkedObjects();
 }
 
+GameObject* PhysicsWorld::getGameObject(b2Body* body)
+{
+    uintptr_t userData = body->GetUserData().pointer;
+    if (userData == 0 || userData == uintptr_t(-1))
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<GameObject*>(userData);
+}
+
+bool PhysicsWorld::isQuiescent(float maxKineticEnergy) const
+{
+    return mAwakeBodyCount == 0 || mMaxKineticEnergy < maxKineticEnergy;
+}
+
+void PhysicsWorld::sleepAll()
+{
+    for (b2Body* body : mAwakeBodies)
+    {
+        body->SetAwake(false);
+    }
+    mAwakeBodyCount = updateSleepStates();
+}
+
+void PhysicsWorld::prepareAwakeBodies(float timeStep)
+{
+    for (b2Body* body : mAwakeBodies)
+    {
+        if (body->IsAwake())
+        {
+            GameObject* gameObject = getGameObject(body);
+            if (gameObject)
+            {
+                gameObject->storePreviousTransform();
+            }
+            if (body->GetType() == b2_dynamicBody)
+            {
+                mCcdManager.update(body, gameObject ? gameObject->getKind() : GameObject::Kind::Other, timeStep);
+            }
+        }
+    }
+}
+
+int PhysicsWorld::updateSleepStates()
+{
+    // Outside of wakeBody() a body only wakes by touching or being jointed to an awake one,
+    // so following the edges of the tracked bodies finds every body the step woke
+    for (std::size_t i = 0; i < mAwakeBodies.size(); ++i)
+    {
+        b2Body* body = mAwakeBodies[i];
+        if (!body->IsAwake())
+        {
+            continue;
+        }
+        for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next)
+        {
+            trackAwakeBody(edge->other);
+        }
+        for (b2JointEdge* edge = body->GetJointList(); edge; edge = edge->next)
+        {
+            trackAwakeBody(edge->other);
+        }
+    }
+
+    // Bodies that fell asleep in the previous step had their last sync then
+    for (b2Body* body : mFallenAsleep)
+    {
+        GameObject* gameObject = getGameObject(body);
+        if (gameObject && mAwakeBodySet.count(body) == 0)
+        {
+            gameObject->updateSleepState(false);
+        }
+    }
+    mFallenAsleep.clear();
+    mObjectsToUpdate.clear();
+
+    int awakeBodies = 0;
+    mMaxKineticEnergy = 0.f;
+    for (std::size_t i = 0; i < mAwakeBodies.size(); ++i)
+    {
+        b2Body* body = mAwakeBodies[i];
+        bool awake = body->IsAwake();
+        if (awake)
+        {
+            // Kept in place, so the order they woke in is preserved
+            mAwakeBodies[awakeBodies++] = body;
+
+            // Per unit mass, so heavy and light bodies settle at the same speed
+            float mass = body->GetMass();
+            if (mass > 0.f)
+            {
+                float linear = body->GetLinearVelocity().LengthSquared();
+                float angular = body->GetAngularVelocity() * body->GetAngularVelocity() * body->GetInertia() / mass;
+                mMaxKineticEnergy = std::max(mMaxKineticEnergy, 0.5f * (linear + angular));
+            }
+        }
+        else
+        {
+            mAwakeBodySet.erase(body);
+            mFallenAsleep.push_back(body);
+            ++mAwakeSetChanges;
+        }
+
+        GameObject* gameObject = getGameObject(body);
+        if (gameObject)
+        {
+            gameObject->updateSleepState(awake);
+            mObjectsToUpdate.push_back(gameObject);
+        }
+    }
+    mAwakeBodies.resize(awakeBodies);
+    return awakeBodies;
+}
+
+void PhysicsWorld::trackAwakeBody(b2Body* body)
+{
+    if (body->GetType() != b2_staticBody && body->IsEnabled() && body->IsAwake() && mAwakeBodySet.insert(body).second)
+    {
+        mAwakeBodies.push_back(body);
+        ++mAwakeSetChanges;
+    }
+}
+
+void PhysicsWorld::forgetBody(b2Body* body)
+{
+    if (mAwakeBodySet.erase(body) > 0)
+    {
+        mAwakeBodies.erase(std::find(mAwakeBodies.begin(), mAwakeBodies.end(), body));
+        ++mAwakeSetChanges;
+    }
+    mFallenAsleep.erase(std::remove(mFallenAsleep.begin(), mFallenAsleep.end(), body), mFallenAsleep.end());
+
+    GameObject* gameObject = getGameObject(body);
+    if (gameObject)
+    {
+        mObjectsToUpdate.erase(std::remove(mObjectsToUpdate.begin(), mObjectsToUpdate.end(), gameObject), mObjectsToUpdate.end());
+    }
+}
+
+void PhysicsWorld::collectNeighbours(b2Body* body)
+{
+    mNeighbours.clear();
+    for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next)
+    {
+        mNeighbours.push_back(edge->other);
+    }
+    for (b2JointEdge* edge = body->GetJointList(); edge; edge = edge->next)
+    {
+        mNeighbours.push_back(edge->other);
+    }
+}
+
+void PhysicsWorld::trackNeighbours()
+{
+    for (b2Body* neighbour : mNeighbours)
+    {
+        trackAwakeBody(neighbour);
+    }
+    mNeighbours.clear();
+}
+
+void PhysicsWorld::setBodyEnabled(b2Body* body, bool enabled)
+{
+    if (!body || body->IsEnabled() == enabled)
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        body->SetEnabled(true);
+        trackAwakeBody(body);
+        return;
+    }
+
+    // A disabled body is not simulated, so it counts as asleep and leaves the awake set
+    body->SetAwake(false);
+    collectNeighbours(body);
+    body->SetEnabled(false);
+    trackNeighbours();
+}
+
+void PhysicsWorld::wakeBody(b2Body* body)
+{
+    if (body && body->GetType() != b2_staticBody)
+    {
+        body->SetAwake(true);
+        trackAwakeBody(body);
+    }
+}
+
 b2Body* PhysicsWorld::createBody(const b2BodyDef& bodyDef) 
 {
     logBodyCreation(bodyDef, "Unknown");
-    return mWorld->CreateBody(&bodyDef);
+    b2Body* body = mWorld->CreateBody(&bodyDef);
+    trackAwakeBody(body);
+    return body;
 }
 
 void PhysicsWorld::destroyBody(b2Body* body)
@@ -41,7 +284,10 @@ void PhysicsWorld::destroyBody(b2Body* body)
         {
             gameObject->setPhysicsBody(nullptr); // Set mPhysicsBody to nullptr
         }
+        collectNeighbours(body);
+        forgetBody(body);
         mWorld->DestroyBody(body);
+        trackNeighbours();
     }
 }
 
@@ -50,6 +296,12 @@ void PhysicsWorld::setGravity(float x, float y)
     mWorld->SetGravity(b2Vec2(x, y));
 }
 
+bool PhysicsWorld::isOutsideWorldBounds(const b2Vec2& position) const
+{
+    return position.x < mWorldBounds.lowerBound.x || position.x > mWorldBounds.upperBound.x ||
+        position.y < mWorldBounds.lowerBound.y || position.y > mWorldBounds.upperBound.y;
+}
+
 void PhysicsWorld::registerGameObject(std::unique_ptr<GameObject> gameObject)
 {
     if (gameObject)
@@ -186,6 +438,7 @@ void PhysicsWorld::applyExplosionForce(const b2Vec2& center, float radius, float
         if (distance <= radius)
         {
             float intensity = (1 - distance / radius) * force;
+            wakeBody(body);
             body->ApplyLinearImpulse(intensity * direction, bodyCenter, true);
 
             GameObject* gameObject = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
@@ -197,7 +450,7 @@ void PhysicsWorld::applyExplosionForce(const b2Vec2& center, float radius, float
                 }
                 else if (auto* block = dynamic_cast<Block*>(gameObject))
                 {
-                    block->damage(intensity);
+                    block->damage(intensity, center);
                 }
             }
         }
@@ -222,7 +475,6 @@ void PhysicsWorld::applyBounceEffect(Projectile* projectile)
     b2Vec2 velocity = body->GetLinearVelocity();
 
     // Increase velocity slightly with each bounce
-    const float BOUNCE_FACTOR = 1.1f;
     body->SetLinearVelocity(BOUNCE_FACTOR * velocity);
 }
 
@@ -259,25 +511,74 @@ void PhysicsWorld::queryAABB(const b2AABB& aabb, std::function<bool(b2Fixture*)>
     mWorld->QueryAABB(&query, aabb);
 }
 
-void PhysicsWorld::removeMarkedBodies()
+void PhysicsWorld::queryObjectsInArea(const b2AABB& aabb, std::vector<GameObject*>& objects)
 {
-    std::vector<b2Body*> bodiesToDestroy;
+    objects.clear();
 
-    for (b2Body* body = mWorld->GetBodyList(); body; )
+    queryAABB(aabb, [&](b2Fixture* fixture)
+        {
+        GameObject* gameObject = reinterpret_cast<GameObject*>(fixture->GetBody()->GetUserData().pointer);
+        if (gameObject && !gameObject->isMarkedForDeletion())
+        {
+            objects.push_back(gameObject);
+        }
+        return true; // Continue querying
+        });
+
+    // A body with several fixtures is reported once per fixture. Only the first report is
+    // kept, so the order stays the one the broadphase found and not that of the addresses.
+    mQueryScratch.clear();
+    for (std::size_t i = 0; i < objects.size(); ++i)
     {
-        b2Body* nextBody = body->GetNext();
+        mQueryScratch.emplace_back(objects[i], i);
+    }
+    std::sort(mQueryScratch.begin(), mQueryScratch.end());
+    mQueryScratch.erase(std::unique(mQueryScratch.begin(), mQueryScratch.end(),
+        [](const std::pair<GameObject*, std::size_t>& a, const std::pair<GameObject*, std::size_t>& b)
+        {
+            return a.first == b.first;
+        }), mQueryScratch.end());
+    if (mQueryScratch.size() == objects.size())
+    {
+        return;
+    }
 
-        GameObject* obj = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
-        if (obj && obj->isMarkedForDeletion())
+    std::sort(mQueryScratch.begin(), mQueryScratch.end(),
+        [](const std::pair<GameObject*, std::size_t>& a, const std::pair<GameObject*, std::size_t>& b)
         {
-            bodiesToDestroy.push_back(body);
-        }
+            return a.second < b.second;
+        });
+    objects.clear();
+    for (const auto& entry : mQueryScratch)
+    {
+        objects.push_back(entry.first);
+    }
+}
 
-        body = nextBody;
+void PhysicsWorld::removeMarkedBodies()
+{
+    // Objects are marked when they are hit, and a body that was hit is awake or has only just
+    // fallen asleep, so the rest of the world does not need looking at
+    std::vector<b2Body*> bodiesToDestroy;
+    for (const std::vector<b2Body*>* bodies : { &mAwakeBodies, &mFallenAsleep })
+    {
+        for (b2Body* body : *bodies)
+        {
+            GameObject* obj = getGameObject(body);
+            if (obj && obj->isMarkedForDeletion())
+            {
+                bodiesToDestroy.push_back(body);
+            }
+        }
     }
 
+    mRemovedBodyCount = static_cast<int>(bodiesToDestroy.size());
     for (b2Body* body : bodiesToDestroy)
     {
+        if (onMarkedBodyDestroyed)
+        {
+            onMarkedBodyDestroyed(*getGameObject(body), *body);
+        }
         destroyBody(body);
     }
 }
@@ -5,7 +5,11 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <utility>
+#include <unordered_set>
 #include <SFML/Graphics.hpp>
+#include "solver_controller.h"
+#include "ccd_manager.h"
 
 class GameObject;
 class Projectile;
@@ -19,10 +23,43 @@ public:
     void update(float deltaTime);
     b2Body* createBody(const b2BodyDef& bodyDef);
     void destroyBody(b2Body* body);
+
+    // Wakes a body and starts tracking it. Needed for every wake from outside a step, such as
+    // a launch or an impulse, wakes spread by contacts and joints are found after each step.
+    void wakeBody(b2Body* body);
+
+    // Use instead of b2Body::SetEnabled, disabling a body wakes whatever it touched
+    void setBodyEnabled(b2Body* body, bool enabled);
     void logBodyCreation(const b2BodyDef& bodyDef, const char* source) const;
     b2Joint* createJoint(const b2JointDef& jointDef);
     void destroyJoint(b2Joint* joint);
     void setGravity(float x, float y);
+
+    // Destroys every body and joint at once by replacing the b2World. Objects that own
+    // bodies must be dropped first, their body pointers are not reset.
+    void clear();
+    int getBodyCount() const { return mWorld->GetBodyCount(); }
+    int getAwakeBodyCount() const { return mAwakeBodyCount; } // As of the last step
+    // Counts bodies joining or leaving the awake set, equal values mean nothing moved in between
+    unsigned int getAwakeSetChanges() const { return mAwakeSetChanges; }
+
+    // Objects whose body moved in the last step or came to rest in it, nothing else has
+    // anything to sync. Valid until the next update.
+    const std::vector<GameObject*>& getObjectsToUpdate() const { return mObjectsToUpdate; }
+    int getRemovedBodyCount() const { return mRemovedBodyCount; } // Marked bodies destroyed by the last update
+
+    // True when every dynamic body slept or moved with less kinetic energy per kilogram
+    // than the threshold during the last step. sleepAll() ends the motion for good, after
+    // which update() stops stepping until something wakes a body.
+    bool isQuiescent(float maxKineticEnergy) const;
+    void sleepAll();
+
+    // Iterations and sub-steps follow the number of awake bodies, against a budget set from
+    // the measured solve time whenever the world is cleared, unless adaptation is off
+    SolverController& getSolverController() { return mSolverController; }
+    void setWorldBounds(const b2AABB& bounds) { mWorldBounds = bounds; }
+    const b2AABB& getWorldBounds() const { return mWorldBounds; }
+    bool isOutsideWorldBounds(const b2Vec2& position) const;
     void registerGameObject(std::unique_ptr<GameObject> gameObject);
     void unregisterGameObject(GameObject* gameObject);
     b2World* getWorld() const { return mWorld.get(); }
@@ -37,19 +74,61 @@ public:
 
     void removeMarkedBodies();
 
+    // Called for each marked object while its body still exists, just before it is destroyed
+    std::function<void(GameObject&, const b2Body&)> onMarkedBodyDestroyed;
+
+    // Broadphase lookup of every game object whose fixtures overlap the given area
+    void queryObjectsInArea(const b2AABB& aabb, std::vector<GameObject*>& objects);
+
     static constexpr float SCALE = 30.f;
     static constexpr float INVERSE_SCALE = 1.f / SCALE;
 
+    // A bouncy projectile's velocity is scaled by this whenever it starts touching something
+    static constexpr float BOUNCE_FACTOR = 1.1f;
+
+    // Default playable area in metres, matches the original 1920x1080 layout
+    static constexpr float DEFAULT_WORLD_WIDTH = 64.f;
+    static constexpr float DEFAULT_WORLD_HEIGHT = 36.f;
+
     void addProjectile(std::unique_ptr<Projectile> projectile);
     void setWindow(sf::RenderWindow* window) { mWindow = window; }
 
 private:
     std::unique_ptr<b2World> mWorld;
     std::vector<std::unique_ptr<GameObject>> mGameObjects;
-    static const int VELOCITY_ITERATIONS = 8;
-    static const int POSITION_ITERATIONS = 3;
+    b2AABB mWorldBounds;
+    SolverController mSolverController;
+    CcdManager mCcdManager;
     sf::RenderWindow* mWindow;
+    int mAwakeBodyCount;
+    float mMaxKineticEnergy; // Per unit mass, highest of the awake bodies in the last step
+    std::vector<std::pair<GameObject*, std::size_t>> mQueryScratch; // Reused by queryObjectsInArea
+
+    // Every non-static body that is awake, in the order it woke. Sleeping bodies are never
+    // visited, so a step costs what moves rather than what the level holds.
+    std::vector<b2Body*> mAwakeBodies;
+    std::unordered_set<b2Body*> mAwakeBodySet;
+    std::vector<b2Body*> mFallenAsleep; // Fell asleep in the last step, synced one more time
+    std::vector<GameObject*> mObjectsToUpdate;
+    std::vector<b2Body*> mNeighbours; // Reused by destroyBody and setBodyEnabled
+    int mRemovedBodyCount;
+    unsigned int mAwakeSetChanges;
+
+    void createWorld(const b2Vec2& gravity);
+
+    // Sleeping bodies do not move, so only awake ones record a transform to interpolate
+    // from and get their continuous collision setting before the step, and report their
+    // sleep state to their object after it
+    void prepareAwakeBodies(float timeStep);
+    int updateSleepStates();
+    void trackAwakeBody(b2Body* body);
+    void forgetBody(b2Body* body);
 
+    // Box2D wakes both bodies of a touching contact or a joint it destroys, after which no
+    // edge leads to them any more. The neighbours are collected first and tracked afterwards.
+    void collectNeighbours(b2Body* body);
+    void trackNeighbours();
+    static GameObject* getGameObject(b2Body* body);
     void cleanupMarkedObjects();
     void queryAABB(const b2AABB& aabb, std::function<bool(b2Fixture*)> callback);
 };
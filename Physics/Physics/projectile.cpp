@@ -43,6 +43,7 @@ Projectile::Projectile(PhysicsWorld& world, const sf::Texture& texture, Type typ
     fixtureDef.density = 1.0f;
     fixtureDef.friction = 0.3f;
     fixtureDef.restitution = 0.5f;
+    fixtureDef.filter = getCollisionFilter();
 
     mPhysicsBody->CreateFixture(&fixtureDef);
 
@@ -86,17 +87,15 @@ void Projectile::update(sf::Time deltaTime)
         }
     }
 
-    if (mPhysicsBody && mWindow)
+    if (mPhysicsBody && mPhysicsWorldPtr)
     {
         b2Vec2 position = mPhysicsBody->GetPosition();
         float angle = mPhysicsBody->GetAngle();
         setPosition(position.x * PhysicsWorld::SCALE, position.y * PhysicsWorld::SCALE);
         setRotation(angle * 180.f / b2_pi);
 
-        // Check if projectile is off-screen
-        sf::Vector2u windowSize = mWindow->getSize();
-        if (position.x < 0 || position.x > windowSize.x / PhysicsWorld::SCALE ||
-            position.y < 0 || position.y > windowSize.y / PhysicsWorld::SCALE)
+        // Check if projectile has left the level
+        if (mPhysicsWorldPtr->isOutsideWorldBounds(position))
         {
             markForDeletion();
         }
@@ -120,12 +119,12 @@ void Projectile::update(sf::Time deltaTime)
     }
 }
 
-void Projectile::render(sf::RenderWindow& window)
+void Projectile::render(RenderSnapshot& snapshot)
 {
-    window.draw(mSprite);
+    snapshot.draw(mSprite);
     if (mHasExplosionEffect)
     {
-        window.draw(mExplosionShape);
+        snapshot.draw(mExplosionShape);
     }
 }
 
@@ -149,6 +148,7 @@ void Projectile::launch(const sf::Vector2f& direction, float force)
         b2Vec2 velocity(direction.x * force * PhysicsWorld::INVERSE_SCALE,
             direction.y * force * PhysicsWorld::INVERSE_SCALE);
         mPhysicsBody->SetLinearVelocity(velocity);
+        mPhysicsWorldPtr->wakeBody(mPhysicsBody);
         mLaunched = true;
 
         switch (mType)
@@ -204,20 +204,27 @@ void Projectile::applyEffect(PhysicsWorld& world, GameObject* other)
         {
             float damage = calculateDamage();
             if (mType == Type::Heavy) damage *= 2.0f; // Double damage for heavy projectiles
-            block->damage(damage);
+            block->damage(damage, mPhysicsBody->GetPosition());
         }
     }
     break;
     case Type::Bouncy:
+        world.applyBounceEffect(this);
         break;
     }
 }
 
+float Projectile::getBounceFactor() const
+{
+    return mType == Type::Bouncy ? PhysicsWorld::BOUNCE_FACTOR : 1.f;
+}
+
 void Projectile::setKinematic(bool isKinematic)
 {
     if (mPhysicsBody && mIsKinematic != isKinematic)
     {
         mPhysicsBody->SetType(isKinematic ? b2_kinematicBody : b2_dynamicBody);
+        mPhysicsWorldPtr->wakeBody(mPhysicsBody);
         mIsKinematic = isKinematic;
     }
 }
@@ -264,6 +271,7 @@ void Projectile::bounce()
 void Projectile::updatePosition(float x, float y)
 {
     setPosition(x, y);
+    resetInterpolation(); // Dragging snaps, there is no previous step to blend from
     if (mPhysicsBody && mIsKinematic)
     {
         mPhysicsBody->SetTransform(b2Vec2(x * PhysicsWorld::INVERSE_SCALE, y * PhysicsWorld::INVERSE_SCALE), mPhysicsBody->GetAngle());
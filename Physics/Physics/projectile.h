@@ -24,8 +24,9 @@ public:
     virtual ~Projectile() = default;
 
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow& window) override;
+    void render(RenderSnapshot& snapshot) override;
     void onCollision(GameObject* other) override;
+    Kind getKind() const override { return Kind::Projectile; }
 
     void launch(const sf::Vector2f& direction, float force);
     Type getType() const { return mType; }
@@ -39,6 +40,8 @@ public:
     const sf::Texture* getTexture() const;
 
     void applyEffect(PhysicsWorld& world, GameObject* other);
+    // What applyEffect scales the velocity by on each contact, 1 for types that do not bounce
+    float getBounceFactor() const;
 
     void setLaunched(bool launched) { mLaunched = launched; }
 
@@ -46,6 +49,7 @@ public:
 
     std::function<void(const Projectile&)> onSplit;
     bool isEffectActive() const;
+    bool isExplosionActive() const { return mHasExplosionEffect; }
 
     void bounce();
 
@@ -0,0 +1,116 @@
+#include "render_snapshot.h"
+#include <algorithm>
+#include <limits>
+
+RenderSnapshot::RenderSnapshot() : mClearColor(sf::Color::White), mOverlayStart(0) {}
+
+void RenderSnapshot::clear(const sf::Color& color)
+{
+    mClearColor = color;
+    mCommands.clear();
+    mOverlayStart = std::numeric_limits<std::size_t>::max();
+    mViews.clear();
+    mSprites.clear();
+    mRectangles.clear();
+    mCircles.clear();
+    mConvexShapes.clear();
+    mVertices.clear();
+}
+
+void RenderSnapshot::setView(const sf::View& view)
+{
+    mCommands.push_back({ CommandType::SetView, mViews.size() });
+    mViews.push_back(view);
+}
+
+void RenderSnapshot::resetView()
+{
+    mCommands.push_back({ CommandType::ResetView, 0 });
+}
+
+void RenderSnapshot::beginOverlay()
+{
+    if (mOverlayStart > mCommands.size())
+    {
+        mOverlayStart = mCommands.size();
+        resetView();
+    }
+}
+
+void RenderSnapshot::draw(const sf::Sprite& sprite)
+{
+    mCommands.push_back({ CommandType::Sprite, mSprites.size() });
+    mSprites.push_back(sprite);
+}
+
+void RenderSnapshot::draw(const sf::RectangleShape& shape)
+{
+    mCommands.push_back({ CommandType::Rectangle, mRectangles.size() });
+    mRectangles.push_back(shape);
+}
+
+void RenderSnapshot::draw(const sf::CircleShape& shape)
+{
+    mCommands.push_back({ CommandType::Circle, mCircles.size() });
+    mCircles.push_back(shape);
+}
+
+void RenderSnapshot::draw(const sf::ConvexShape& shape)
+{
+    mCommands.push_back({ CommandType::Convex, mConvexShapes.size() });
+    mConvexShapes.push_back(shape);
+}
+
+void RenderSnapshot::draw(const sf::VertexArray& vertices, const sf::Texture* texture)
+{
+    mCommands.push_back({ CommandType::Vertices, mVertices.size() });
+    mVertices.push_back({ vertices, texture });
+}
+
+void RenderSnapshot::replayScene(sf::RenderTarget& target, const sf::View& defaultView) const
+{
+    target.setView(defaultView);
+    target.clear(mClearColor);
+    replayCommands(target, defaultView, 0, std::min(mOverlayStart, mCommands.size()));
+}
+
+void RenderSnapshot::replayOverlay(sf::RenderTarget& target, const sf::View& defaultView) const
+{
+    replayCommands(target, defaultView, std::min(mOverlayStart, mCommands.size()), mCommands.size());
+}
+
+void RenderSnapshot::replayCommands(sf::RenderTarget& target, const sf::View& defaultView, std::size_t begin, std::size_t end) const
+{
+    target.setView(defaultView);
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const Command& command = mCommands[i];
+        switch (command.type)
+        {
+        case CommandType::SetView:
+            target.setView(mViews[command.index]);
+            break;
+        case CommandType::ResetView:
+            target.setView(defaultView);
+            break;
+        case CommandType::Sprite:
+            target.draw(mSprites[command.index]);
+            break;
+        case CommandType::Rectangle:
+            target.draw(mRectangles[command.index]);
+            break;
+        case CommandType::Circle:
+            target.draw(mCircles[command.index]);
+            break;
+        case CommandType::Convex:
+            target.draw(mConvexShapes[command.index]);
+            break;
+        case CommandType::Vertices:
+            target.draw(mVertices[command.index].vertices, mVertices[command.index].texture);
+            break;
+        }
+    }
+
+    target.setView(defaultView);
+}
@@ -0,0 +1,75 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Immutable description of one frame, recorded by the simulation thread and
+// replayed by the render thread. Drawables are copied in, so the objects that
+// produced them are free to change or be destroyed once recording is done.
+// Textures are referenced, not copied, and must outlive the snapshot. Text is recorded as
+// textured vertices from a GlyphAtlas, so no font is touched while replaying.
+class RenderSnapshot
+{
+public:
+    RenderSnapshot();
+
+    void clear(const sf::Color& color);
+
+    void setView(const sf::View& view);
+    void resetView(); // Back to the default view given to replay
+
+    void draw(const sf::Sprite& sprite);
+    void draw(const sf::RectangleShape& shape);
+    void draw(const sf::CircleShape& shape);
+    void draw(const sf::ConvexShape& shape);
+    void draw(const sf::VertexArray& vertices, const sf::Texture* texture = nullptr);
+
+    // Everything recorded after this is overlay (HUD, menus) and is kept at full resolution
+    void beginOverlay();
+
+    // The default view is passed in so a scaled down target still sees window coordinates.
+    // replayScene clears the target, replayOverlay draws on top of whatever is there.
+    void replayScene(sf::RenderTarget& target, const sf::View& defaultView) const;
+    void replayOverlay(sf::RenderTarget& target, const sf::View& defaultView) const;
+
+private:
+    void replayCommands(sf::RenderTarget& target, const sf::View& defaultView, std::size_t begin, std::size_t end) const;
+
+    enum class CommandType
+    {
+        SetView,
+        ResetView,
+        Sprite,
+        Rectangle,
+        Circle,
+        Convex,
+        Vertices
+    };
+
+    struct Command
+    {
+        CommandType type;
+        std::size_t index;
+    };
+
+    struct TexturedVertices
+    {
+        sf::VertexArray vertices;
+        const sf::Texture* texture;
+    };
+
+    sf::Color mClearColor;
+    std::vector<Command> mCommands;
+    std::size_t mOverlayStart;
+
+    // Storage is kept between frames so recording does not reallocate once warmed up
+    std::vector<sf::View> mViews;
+    std::vector<sf::Sprite> mSprites;
+    std::vector<sf::RectangleShape> mRectangles;
+    std::vector<sf::CircleShape> mCircles;
+    std::vector<sf::ConvexShape> mConvexShapes;
+    std::vector<TexturedVertices> mVertices;
+};
+
+#endif
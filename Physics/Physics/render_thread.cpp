@@ -0,0 +1,217 @@
+#include "render_thread.h"
+#include "startup_profiler.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <iostream>
+
+const float RenderThread::MIN_RENDER_SCALE = 0.5f;
+const float RenderThread::MAX_RENDER_SCALE = 1.0f;
+const sf::Time RenderThread::FRAME_BUDGET = sf::milliseconds(14); // Headroom under a 60 Hz frame
+const sf::Time RenderThread::SCALE_CHANGE_INTERVAL = sf::seconds(1.f);
+const int RenderThread::FRAME_TIME_SAMPLE_RATE = 8;
+
+RenderThread::RenderThread() : mWindow(nullptr), mRunning(false), mIsDrawing(false), mIsFlushed(true), mPresentedFirstFrame(false),
+mRenderScale(MAX_RENDER_SCALE), mAdaptiveScale(true), mTargetScale(0.f), mTargetSize(0, 0),
+mAverageFrameTime(sf::Time::Zero), mFrameCounter(0) {}
+
+RenderThread::~RenderThread()
+{
+    stop();
+}
+
+void RenderThread::start(sf::RenderWindow& window)
+{
+    if (mRunning)
+    {
+        return;
+    }
+
+    mWindow = &window;
+
+    // The context can only be active on one thread at a time
+    mWindow->setActive(false);
+    mRunning = true;
+    mThread = std::thread(&RenderThread::run, this);
+    std::cout << "Render thread started" << std::endl;
+}
+
+void RenderThread::stop()
+{
+    if (!mRunning)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mRunning = false;
+    }
+    mWakeCondition.notify_one();
+
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+
+    mWindow->setActive(true);
+    mIsFlushed = true;
+    std::cout << "Render thread stopped" << std::endl;
+}
+
+RenderSnapshot& RenderThread::beginSnapshot()
+{
+    return mSnapshots.getWriteBuffer();
+}
+
+void RenderThread::publish()
+{
+    {
+        // Taking the lock orders the publish against the render thread's check before it waits
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mSnapshots.publish();
+    }
+    mIsFlushed = false;
+    mWakeCondition.notify_one();
+}
+
+void RenderThread::flush()
+{
+    if (!mRunning || mIsFlushed)
+    {
+        return;
+    }
+
+    // The render thread marks itself as drawing before it takes a snapshot, so once nothing
+    // is pending and it is not drawing, no published snapshot will be read again
+    while (mSnapshots.hasNewData() || mIsDrawing)
+    {
+        std::this_thread::yield();
+    }
+
+    mIsFlushed = true;
+}
+
+void RenderThread::setRenderScale(float scale)
+{
+    mAdaptiveScale = false;
+    mRenderScale = std::max(MIN_RENDER_SCALE, std::min(scale, MAX_RENDER_SCALE));
+}
+
+void RenderThread::run()
+{
+    mWindow->setActive(true);
+
+    while (mRunning)
+    {
+        mIsDrawing = true;
+        if (mSnapshots.consume())
+        {
+            drawFrame(mSnapshots.getReadBuffer());
+            mIsDrawing = false;
+        }
+        else
+        {
+            // Nothing new to show, the last frame stays on screen until the next publish
+            mIsDrawing = false;
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWakeCondition.wait(lock, [this]() { return !mRunning || mSnapshots.hasNewData(); });
+        }
+    }
+
+    mWindow->setActive(false);
+}
+
+void RenderThread::drawFrame(const RenderSnapshot& snapshot)
+{
+    // Only every few frames wait for the GPU to finish, which gives a real GPU frame time
+    // without losing CPU/GPU overlap on the others
+    bool measure = mAdaptiveScale && ++mFrameCounter % FRAME_TIME_SAMPLE_RATE == 0;
+    sf::Clock frameClock;
+
+    const sf::View& defaultView = mWindow->getDefaultView();
+    float scale = mRenderScale;
+
+    if (scale >= MAX_RENDER_SCALE)
+    {
+        snapshot.replayScene(*mWindow, defaultView);
+    }
+    else
+    {
+        // Recreate the off-screen target when the scale or the window size changed
+        sf::Vector2u windowSize = mWindow->getSize();
+        if (scale != mTargetScale || windowSize != mTargetSize)
+        {
+            unsigned int width = std::max(1u, static_cast<unsigned int>(windowSize.x * scale));
+            unsigned int height = std::max(1u, static_cast<unsigned int>(windowSize.y * scale));
+            if (!mSceneTarget.create(width, height))
+            {
+                std::cout << "Failed to create scaled render target, rendering at full resolution" << std::endl;
+                mRenderScale = MAX_RENDER_SCALE;
+                mAdaptiveScale = false;
+                snapshot.replayScene(*mWindow, defaultView);
+                snapshot.replayOverlay(*mWindow, defaultView);
+                mWindow->display();
+                return;
+            }
+            mSceneTarget.setSmooth(true);
+            mSceneSprite.setTexture(mSceneTarget.getTexture(), true);
+            mSceneSprite.setScale(windowSize.x / static_cast<float>(width), windowSize.y / static_cast<float>(height));
+            mTargetScale = scale;
+            mTargetSize = windowSize;
+        }
+
+        snapshot.replayScene(mSceneTarget, defaultView);
+        mSceneTarget.display();
+
+        mWindow->setView(mWindow->getDefaultView());
+        mWindow->draw(mSceneSprite);
+    }
+
+    // HUD and menus stay sharp at the native resolution
+    snapshot.replayOverlay(*mWindow, defaultView);
+
+    if (measure)
+    {
+        glFinish();
+        adaptRenderScale(frameClock.getElapsedTime());
+    }
+
+    mWindow->display();
+
+    if (!mPresentedFirstFrame)
+    {
+        mPresentedFirstFrame = true;
+        StartupProfiler::getInstance().markFirstFrame();
+    }
+}
+
+void RenderThread::adaptRenderScale(sf::Time frameTime)
+{
+    // Smooth out single slow frames
+    mAverageFrameTime = mAverageFrameTime == sf::Time::Zero ? frameTime : (mAverageFrameTime * 0.8f + frameTime * 0.2f);
+
+    // Changes are rate limited, and the scale only grows back once there is clear headroom
+    if (mScaleChangeClock.getElapsedTime() < SCALE_CHANGE_INTERVAL)
+    {
+        return;
+    }
+
+    float scale = mRenderScale;
+    if (mAverageFrameTime > FRAME_BUDGET && scale > MIN_RENDER_SCALE)
+    {
+        scale = std::max(MIN_RENDER_SCALE, scale - 0.1f);
+    }
+    else if (mAverageFrameTime < FRAME_BUDGET * 0.6f && scale < MAX_RENDER_SCALE)
+    {
+        scale = std::min(MAX_RENDER_SCALE, scale + 0.05f);
+    }
+    else
+    {
+        return;
+    }
+
+    std::cout << "Render scale " << mRenderScale << " -> " << scale
+        << " (GPU frame time " << mAverageFrameTime.asMilliseconds() << " ms)" << std::endl;
+    mRenderScale = scale;
+    mScaleChangeClock.restart();
+}
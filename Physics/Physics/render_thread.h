@@ -0,0 +1,76 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "render_snapshot.h"
+#include "triple_buffer.h"
+
+// Owns the window's OpenGL context and draws the snapshots published by the
+// simulation thread. Events must still be polled on the thread that created the window.
+class RenderThread
+{
+public:
+    RenderThread();
+    ~RenderThread();
+
+    void start(sf::RenderWindow& window);
+    void stop();
+    bool isRunning() const { return mRunning; }
+
+    // Simulation side: record into the returned snapshot, then publish it
+    RenderSnapshot& beginSnapshot();
+    void publish();
+    bool isSnapshotPending() const { return mSnapshots.hasNewData(); }
+
+    // Waits until the render thread no longer uses any published snapshot, call before
+    // destroying textures or fonts that earlier snapshots may still reference
+    void flush();
+
+    // Fraction of the window resolution the scene is rendered at before being upscaled.
+    // A fixed scale turns off the automatic adjustment.
+    void setRenderScale(float scale);
+    void setAdaptiveRenderScale(bool adaptive) { mAdaptiveScale = adaptive; }
+    float getRenderScale() const { return mRenderScale; }
+
+private:
+    void run();
+    void drawFrame(const RenderSnapshot& snapshot);
+    void adaptRenderScale(sf::Time frameTime);
+
+    sf::RenderWindow* mWindow;
+    std::thread mThread;
+    std::atomic<bool> mRunning;
+    std::atomic<bool> mIsDrawing;
+    bool mIsFlushed;
+    bool mPresentedFirstFrame;
+
+    TripleBuffer<RenderSnapshot> mSnapshots;
+
+    // Lets the render thread sleep until a snapshot is published, menus can go a long time without one
+    std::mutex mWakeMutex;
+    std::condition_variable mWakeCondition;
+
+    // Internal resolution, only the render thread touches the off-screen target
+    std::atomic<float> mRenderScale;
+    std::atomic<bool> mAdaptiveScale;
+    sf::RenderTexture mSceneTarget;
+    sf::Sprite mSceneSprite;
+    float mTargetScale;
+    sf::Vector2u mTargetSize;
+
+    sf::Time mAverageFrameTime;
+    sf::Clock mScaleChangeClock;
+    int mFrameCounter;
+
+    static const float MIN_RENDER_SCALE;
+    static const float MAX_RENDER_SCALE;
+    static const sf::Time FRAME_BUDGET;
+    static const sf::Time SCALE_CHANGE_INTERVAL;
+    static const int FRAME_TIME_SAMPLE_RATE;
+};
+
+#endif
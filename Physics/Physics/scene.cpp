@@ -2,12 +2,36 @@
 #include "game_object.h"
 #include <iostream>
 
-Scene::Scene() : mIsCompleted(false), mWindow(nullptr) {}
+Scene::Scene() : mIsCompleted(false), mWindow(nullptr), mRenderAlpha(1.f) {}
 
 void Scene::update(sf::Time deltaTime)
 {
     mPhysicsWorld.update(deltaTime.asSeconds());
 
+    // Only objects whose body moved or came to rest in the step have anything to sync
+    for (GameObject* object : mPhysicsWorld.getObjectsToUpdate())
+    {
+        if (isUpdatedByScene(*object) && !object->isMarkedForDeletion())
+        {
+            object->update(deltaTime);
+        }
+    }
+
+    // Objects only become marked on steps that destroy bodies
+    if (mPhysicsWorld.getRemovedBodyCount() > 0)
+    {
+        removeMarkedObjects();
+    }
+}
+
+bool Scene::isUpdatedByScene(const GameObject& object)
+{
+    // Projectiles and debris are owned and updated by the level
+    return object.getKind() != GameObject::Kind::Projectile && object.getKind() != GameObject::Kind::Debris;
+}
+
+void Scene::removeMarkedObjects()
+{
     for (auto it = mGameObjects.begin(); it != mGameObjects.end();)
     {
         if (*it == nullptr)
@@ -19,17 +43,22 @@ void Scene::update(sf::Time deltaTime)
 
         if ((*it)->isMarkedForDeletion())
         {
+            mPhysicsWorld.destroyBody((*it)->getPhysicsBody());
             mPhysicsWorld.unregisterGameObject(it->get());
             it = mGameObjects.erase(it);
         }
         else 
         {
-            (*it)->update(deltaTime);
             ++it;
         }
     }
 }
 
+void Scene::updateFrame(sf::Time deltaTime)
+{
+    mCamera.update(deltaTime);
+}
+
 void Scene::addGameObject(std::unique_ptr<GameObject> gameObject)
 {
     if (gameObject)
@@ -48,23 +77,34 @@ void Scene::setWindow(sf::RenderWindow* window)
 {
     mWindow = window;
     mGameUI.initialize(window);
+    mCamera.initialize(sf::Vector2f(window->getSize()));
+}
+
+void Scene::render(RenderSnapshot& snapshot)
+{
+    snapshot.setView(mCamera.getView());
+    renderVisibleObjects(snapshot);
+    snapshot.beginOverlay();
+
+    mGameUI.render(snapshot);
 }
 
-void Scene::render(sf::RenderWindow& window)
+void Scene::renderVisibleObjects(RenderSnapshot& snapshot)
 {
-    for (const auto& object : mGameObjects)
+    // Only objects the broadphase reports inside the camera rectangle are drawn,
+    // so render cost follows what is on screen rather than the size of the level
+    mPhysicsWorld.queryObjectsInArea(mCamera.getVisibleAABB(), mVisibleObjects);
+
+    for (GameObject* object : mVisibleObjects)
     {
-        if (object)
-        {
-            object->render(window);
-        }
-        else
+        // Projectiles belong to the level and are drawn on top of everything by it
+        if (object->getKind() == GameObject::Kind::Projectile)
         {
-            std::cout << "Encountered null GameObject in render loop.\n";
+            continue;
         }
+        object->applyInterpolation(mRenderAlpha);
+        object->render(snapshot);
     }
-
-    mGameUI.render(window);
 }
 
 void Scene::updateUI(int projectilesLeft, int enemiesLeft, int currentLevel)
@@ -7,6 +7,8 @@
 #include "game_object.h"
 #include "physics_world.h"
 #include "game_UI.h"
+#include "camera.h"
+#include "render_snapshot.h"
 
 class Scene
 {
@@ -17,10 +19,17 @@ public:
     virtual void initialize() = 0;
     virtual void handleEvent(const sf::Event& event) = 0;
     virtual void update(sf::Time deltaTime);
-    virtual void render(sf::RenderWindow& window);
+
+    // Called once per rendered frame with unscaled time, for what follows the player rather
+    // than the simulation, so it keeps its pace in slow motion
+    virtual void updateFrame(sf::Time deltaTime);
+    virtual void render(RenderSnapshot& snapshot);
 
     void addGameObject(std::unique_ptr<GameObject> object);
     void setWindow(sf::RenderWindow* window);
+
+    // Fraction of a fixed step left over when rendering, used to interpolate between steps
+    void setRenderAlpha(float alpha) { mRenderAlpha = alpha; }
     sf::RenderWindow* getWindow() const { return mWindow; }
 
     bool isCompleted() const;
@@ -31,8 +40,16 @@ protected:
     sf::RenderWindow* mWindow;
     bool mIsCompleted;
     GameUI mGameUI;
+    Camera mCamera;
+    float mRenderAlpha;
 
     void updateUI(int projectilesLeft, int enemiesLeft, int currentLevel);
+    void renderVisibleObjects(RenderSnapshot& snapshot);
+    void removeMarkedObjects(); // Drops marked objects along with any body they still have
+    static bool isUpdatedByScene(const GameObject& object);
+
+private:
+    std::vector<GameObject*> mVisibleObjects; // Reused every frame to avoid reallocating
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "solver_controller.h"
+#include <algorithm>
+
+namespace
+{
+    // Ordered from most to least accurate. The first entry is the original fixed setting.
+    const SolverController::Settings QUALITY_LEVELS[] =
+    {
+        { 8, 3, 1 },
+        { 6, 3, 1 },
+        { 5, 2, 1 },
+        { 4, 2, 1 },
+        { 3, 1, 1 },
+        { 2, 1, 1 },
+    };
+
+    const int QUALITY_LEVEL_COUNT = sizeof(QUALITY_LEVELS) / sizeof(QUALITY_LEVELS[0]);
+}
+
+std::atomic<float> SolverController::sSolveTimePerUnit(0.f);
+
+const float SolverController::DEFAULT_FRAME_BUDGET = 4.f;
+const float SolverController::DEFAULT_BUDGET = 4000.f; // Until a solve has been measured, about 360 awake bodies at the default level
+const float SolverController::SOLVE_TIME_SMOOTHING = 0.05f;
+const int SolverController::DEFAULT_LEVEL = 0;
+const int SolverController::RECOVER_STEPS = 60;
+const float SolverController::RECOVER_HEADROOM = 0.7f;
+
+SolverController::SolverController() : mFrameBudget(DEFAULT_FRAME_BUDGET), mBudget(DEFAULT_BUDGET), mAdaptive(true)
+{
+    reset();
+}
+
+void SolverController::setAdaptive(bool adaptive)
+{
+    mAdaptive = adaptive;
+    reset();
+}
+
+const SolverController::Settings& SolverController::getSettings() const
+{
+    return QUALITY_LEVELS[mAdaptive ? mLevel : DEFAULT_LEVEL];
+}
+
+void SolverController::reset()
+{
+    mLevel = DEFAULT_LEVEL;
+    mUnderBudgetSteps = 0;
+
+    float solveTimePerUnit = sSolveTimePerUnit.load();
+    mBudget = solveTimePerUnit > 0.f ? mFrameBudget / solveTimePerUnit : DEFAULT_BUDGET;
+}
+
+int SolverController::getCost(int level) const
+{
+    // Solve time grows roughly with the total number of iterations run per body and step
+    const Settings& settings = QUALITY_LEVELS[level];
+    return (settings.velocityIterations + settings.positionIterations) * settings.subSteps;
+}
+
+int SolverController::findAffordableLevel(int awakeBodies) const
+{
+    int level = mLevel;
+    while (level < QUALITY_LEVEL_COUNT - 1 && getCost(level) * awakeBodies > mBudget)
+    {
+        ++level;
+    }
+    return level;
+}
+
+void SolverController::record(float solveTime, int awakeBodies)
+{
+    if (!mAdaptive)
+    {
+        return;
+    }
+
+    // Only calibrates the budget of the next level start, never this level's choices
+    int work = getCost(mLevel) * awakeBodies;
+    if (solveTime > 0.f && work > 0)
+    {
+        float sample = solveTime / work;
+        float solveTimePerUnit = sSolveTimePerUnit.load();
+        sSolveTimePerUnit.store(solveTimePerUnit > 0.f ? solveTimePerUnit + (sample - solveTimePerUnit) * SOLVE_TIME_SMOOTHING : sample);
+    }
+
+    // A collapse wakes many bodies at once, drop straight to a level that fits them
+    int affordable = findAffordableLevel(awakeBodies);
+    if (affordable > mLevel)
+    {
+        setLevel(affordable);
+        return;
+    }
+
+    // Only step back up when the better level fits with headroom to spare
+    if (mLevel > 0 && getCost(mLevel - 1) * awakeBodies < mBudget * RECOVER_HEADROOM)
+    {
+        if (++mUnderBudgetSteps >= RECOVER_STEPS)
+        {
+            setLevel(mLevel - 1);
+        }
+    }
+    else
+    {
+        mUnderBudgetSteps = 0;
+    }
+}
+
+void SolverController::setLevel(int level)
+{
+    mLevel = std::max(0, std::min(level, QUALITY_LEVEL_COUNT - 1));
+    mUnderBudgetSteps = 0;
+}
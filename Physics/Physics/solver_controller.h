@@ -0,0 +1,66 @@
+#ifndef SOLVER_CONTROLLER_H
+#define SOLVER_CONTROLLER_H
+
+#include <box2d/box2d.h>
+#include <atomic>
+
+// Picks solver iterations and sub-steps for each physics step. The frame budget is given
+// in milliseconds of solve time; when a level starts it is turned into a budget of solver
+// work, using the b2Profile solve time measured over every step so far. Within the level
+// quality then follows the number of awake bodies alone: it drops as soon as they would
+// need more work than the budget allows and only climbs back after a sustained run of
+// steps with room to spare, so it does not oscillate. No clock is read between two level
+// starts, so a level plays out the same however its steps are spread over frames.
+class SolverController
+{
+public:
+    struct Settings
+    {
+        int velocityIterations;
+        int positionIterations;
+        int subSteps;
+    };
+
+    SolverController();
+
+    // Milliseconds of solve time each step may take, used from the next level start
+    void setFrameBudget(float milliseconds) { mFrameBudget = milliseconds; }
+    float getFrameBudget() const { return mFrameBudget; }
+
+    // When disabled the default quality is always used
+    void setAdaptive(bool adaptive);
+    bool isAdaptive() const { return mAdaptive; }
+
+    const Settings& getSettings() const;
+
+    // Feeds back the b2Profile solve time of the last step, summed over its sub-steps, and
+    // how many bodies were awake after it
+    void record(float solveTime, int awakeBodies);
+
+    // Called when a level starts, fixes the work budget for the level from what has been measured
+    void reset();
+
+    static const float DEFAULT_FRAME_BUDGET;
+
+private:
+    int getCost(int level) const;
+    int findAffordableLevel(int awakeBodies) const;
+    void setLevel(int level);
+
+    float mFrameBudget;
+    float mBudget; // Solver work per step, see getCost
+    bool mAdaptive;
+    int mLevel;
+    int mUnderBudgetSteps;
+
+    // Milliseconds of solve per unit of work, shared so a level built later starts calibrated
+    static std::atomic<float> sSolveTimePerUnit;
+
+    static const float DEFAULT_BUDGET;
+    static const float SOLVE_TIME_SMOOTHING;
+    static const int DEFAULT_LEVEL;
+    static const int RECOVER_STEPS;
+    static const float RECOVER_HEADROOM;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "startup_profiler.h"
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+const char* const StartupProfiler::METRICS_PATH = "startup_metrics.csv";
+
+StartupProfiler& StartupProfiler::getInstance()
+{
+    static StartupProfiler instance;
+    return instance;
+}
+
+StartupProfiler::StartupProfiler() : mFirstFrameTime(sf::Time::Zero), mHasFirstFrame(false), mReported(false) {}
+
+void StartupProfiler::markPhase(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mReported)
+    {
+        mPhases.push_back({ name, mClock.getElapsedTime() });
+    }
+}
+
+void StartupProfiler::markFirstFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mHasFirstFrame)
+    {
+        mFirstFrameTime = mClock.getElapsedTime();
+        mHasFirstFrame = true;
+    }
+}
+
+void StartupProfiler::report()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mReported)
+    {
+        return;
+    }
+    mReported = true;
+
+    sf::Time total = mClock.getElapsedTime();
+    sf::Time start = sf::Time::Zero;
+    for (const Phase& phase : mPhases)
+    {
+        std::cout << "[startup] " << phase.name << ": " << (phase.end - start).asMilliseconds() << " ms" << std::endl;
+        start = phase.end;
+    }
+    if (mHasFirstFrame)
+    {
+        std::cout << "[startup] Time to first frame: " << mFirstFrameTime.asMilliseconds() << " ms" << std::endl;
+    }
+    std::cout << "[startup] Time to interactive: " << total.asMilliseconds() << " ms" << std::endl;
+
+    // Timestamp, time to first frame, time to interactive, then every phase
+    std::ofstream metrics(METRICS_PATH, std::ios::app);
+    if (metrics)
+    {
+        metrics << std::time(nullptr) << ',' << (mHasFirstFrame ? mFirstFrameTime.asMilliseconds() : -1) << ',' << total.asMilliseconds();
+        for (const Phase& phase : mPhases)
+        {
+            metrics << ',' << phase.name << '=' << phase.end.asMilliseconds();
+        }
+        metrics << '\n';
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <SFML/System.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Records how long each startup phase takes, measured from the first call to getInstance.
+// The report goes to the console and one line per run is appended to a metrics file, so
+// time to first frame can be tracked across builds.
+class StartupProfiler
+{
+public:
+    static StartupProfiler& getInstance();
+
+    void markPhase(const std::string& name);
+
+    // Called by the render thread once the first frame is on screen
+    void markFirstFrame();
+
+    // Only the first call reports, phases marked afterwards are ignored
+    void report();
+
+private:
+    StartupProfiler();
+    StartupProfiler(const StartupProfiler&) = delete;
+    StartupProfiler& operator=(const StartupProfiler&) = delete;
+
+    struct Phase
+    {
+        std::string name;
+        sf::Time end;
+    };
+
+    std::mutex mMutex;
+    sf::Clock mClock;
+    std::vector<Phase> mPhases;
+    sf::Time mFirstFrameTime;
+    bool mHasFirstFrame;
+    bool mReported;
+
+    static const char* const METRICS_PATH;
+};
+
+#endif
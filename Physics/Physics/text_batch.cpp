@@ -0,0 +1,27 @@
+#include "text_batch.h"
+
+TextBatch::TextBatch() : mVertices(sf::Triangles), mTexture(nullptr) {}
+
+void TextBatch::clear()
+{
+    mVertices.clear();
+}
+
+void TextBatch::add(const BitmapText& text)
+{
+    if (!text.getAtlas())
+    {
+        return;
+    }
+
+    mTexture = &text.getAtlas()->getTexture();
+    text.appendTo(mVertices);
+}
+
+void TextBatch::draw(RenderSnapshot& snapshot) const
+{
+    if (mVertices.getVertexCount() > 0)
+    {
+        snapshot.draw(mVertices, mTexture);
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef TEXT_BATCH_H
+#define TEXT_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include "bitmap_text.h"
+#include "render_snapshot.h"
+
+// Collects BitmapTexts that share a GlyphAtlas into one vertex array, drawn with one call
+class TextBatch
+{
+public:
+    TextBatch();
+
+    void clear();
+    void add(const BitmapText& text);
+    void draw(RenderSnapshot& snapshot) const;
+
+private:
+    sf::VertexArray mVertices;
+    const sf::Texture* mTexture;
+};
+
+#endif
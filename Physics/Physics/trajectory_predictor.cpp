@@ -0,0 +1,325 @@
+#include "trajectory_predictor.h"
+#include "physics_world.h"
+
+const float TrajectoryPredictor::TIME_STEP = 1.f / 60.f; // Same fixed step as the game
+const std::size_t TrajectoryPredictor::MAX_CACHED_PATHS = 512;
+
+namespace
+{
+    void copyFixtures(const b2Body* from, b2Body* to)
+    {
+        // CreateFixture clones the shape, so the source can go away afterwards
+        for (const b2Fixture* fixture = from->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            b2FixtureDef fixtureDef;
+            fixtureDef.shape = fixture->GetShape();
+            fixtureDef.density = fixture->GetDensity();
+            fixtureDef.friction = fixture->GetFriction();
+            fixtureDef.restitution = fixture->GetRestitution();
+            fixtureDef.filter = fixture->GetFilterData();
+            to->CreateFixture(&fixtureDef);
+        }
+    }
+
+    std::uint64_t makeKey(const sf::Vector2i& pull, int type)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pull.x) & 0xFFFFFF) << 32) |
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pull.y) & 0xFFFFFF) << 8) |
+            static_cast<std::uint64_t>(type & 0xFF);
+    }
+
+    class AnyFixtureQuery : public b2QueryCallback
+    {
+    public:
+        AnyFixtureQuery() : found(false) {}
+
+        bool ReportFixture(b2Fixture*) override
+        {
+            found = true;
+            return false; // One is enough
+        }
+
+        bool found;
+    };
+}
+
+TrajectoryPredictor::TrajectoryPredictor() : mWorld(std::make_unique<b2World>(b2Vec2(0.f, 0.f))),
+mTemplate(nullptr), mProjectile(nullptr), mTemplateType(-1), mBounceFactor(1.f),
+mSettings(SolverController().getSettings()), mIsBuilt(false),
+mSkippedAwakeBodies(false)
+{
+    mWorld->SetContactListener(this);
+    mLocalBounds.lowerBound.SetZero();
+    mLocalBounds.upperBound.SetZero();
+    mBounds = mLocalBounds;
+}
+
+TrajectoryPredictor::~TrajectoryPredictor() = default;
+
+void TrajectoryPredictor::clearWorld()
+{
+    // Destroying the bodies hands their memory back to the world's allocators, which the
+    // next rebuild takes it from again
+    for (b2Body* body = mWorld->GetBodyList(); body; )
+    {
+        b2Body* next = body->GetNext();
+        mWorld->DestroyBody(body);
+        body = next;
+    }
+    mTemplate = nullptr;
+    mProjectile = nullptr;
+    mTemplateType = -1;
+}
+
+void TrajectoryPredictor::rebuild(b2World& source, const b2Body* projectile, const b2AABB& bounds)
+{
+    clearWorld();
+    mPaths.clear();
+    mWorld->SetGravity(source.GetGravity());
+    mBounds = bounds;
+    mSkippedAwakeBodies = false;
+
+    for (b2Body* body = source.GetBodyList(); body; body = body->GetNext())
+    {
+        // Parked debris is disabled and not part of the level
+        if (body == projectile || !body->IsEnabled())
+        {
+            continue;
+        }
+        if (body->GetType() != b2_staticBody && body->IsAwake())
+        {
+            mSkippedAwakeBodies = true;
+            continue;
+        }
+
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_staticBody;
+        bodyDef.position = body->GetPosition();
+        bodyDef.angle = body->GetAngle();
+        b2Body* copy = mWorld->CreateBody(&bodyDef);
+
+        for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            b2FixtureDef fixtureDef;
+            fixtureDef.shape = fixture->GetShape();
+            fixtureDef.friction = fixture->GetFriction();
+            fixtureDef.restitution = fixture->GetRestitution();
+            fixtureDef.isSensor = fixture->IsSensor();
+            fixtureDef.filter = fixture->GetFilterData();
+            copy->CreateFixture(&fixtureDef);
+        }
+    }
+
+    mIsBuilt = true;
+}
+
+void TrajectoryPredictor::setProjectile(const b2Body* projectile, int type, float bounceFactor)
+{
+    if (!mIsBuilt || !projectile || type == mTemplateType)
+    {
+        return;
+    }
+
+    mBounceFactor = bounceFactor;
+
+    if (mProjectile)
+    {
+        mWorld->DestroyBody(mProjectile);
+        mProjectile = nullptr;
+    }
+    if (mTemplate)
+    {
+        mWorld->DestroyBody(mTemplate);
+        mTemplate = nullptr;
+    }
+
+    // The projectile waits in the slingshot as a kinematic body, predictions fly it as the
+    // dynamic body it turns into on launch
+    mProjectileDef = b2BodyDef();
+    mProjectileDef.type = b2_dynamicBody;
+    mProjectileDef.bullet = true;
+    mProjectileDef.fixedRotation = projectile->IsFixedRotation();
+    mProjectileDef.gravityScale = projectile->GetGravityScale();
+    mProjectileDef.linearDamping = projectile->GetLinearDamping();
+    mProjectileDef.angularDamping = projectile->GetAngularDamping();
+
+    b2BodyDef templateDef = mProjectileDef;
+    templateDef.enabled = false;
+    mTemplate = mWorld->CreateBody(&templateDef);
+    copyFixtures(projectile, mTemplate);
+
+    b2Transform identity;
+    identity.SetIdentity();
+    bool first = true;
+    for (const b2Fixture* fixture = mTemplate->GetFixtureList(); fixture; fixture = fixture->GetNext())
+    {
+        for (int child = 0; child < fixture->GetShape()->GetChildCount(); ++child)
+        {
+            b2AABB aabb;
+            fixture->GetShape()->ComputeAABB(&aabb, identity, child);
+            if (first)
+            {
+                mLocalBounds = aabb;
+                first = false;
+            }
+            else
+            {
+                mLocalBounds.Combine(aabb);
+            }
+        }
+    }
+
+    mTemplateType = type;
+}
+
+void TrajectoryPredictor::setSolverSettings(const SolverController::Settings& settings)
+{
+    if (settings.velocityIterations == mSettings.velocityIterations &&
+        settings.positionIterations == mSettings.positionIterations &&
+        settings.subSteps == mSettings.subSteps)
+    {
+        return;
+    }
+
+    // Paths stepped with the old settings no longer match what a launch would do
+    mSettings = settings;
+    mPaths.clear();
+}
+
+void TrajectoryPredictor::BeginContact(b2Contact* contact)
+{
+    // Mirrors Projectile::applyEffect, which the game calls from its own BeginContact
+    if (mProjectile && mBounceFactor != 1.f &&
+        (contact->GetFixtureA()->GetBody() == mProjectile || contact->GetFixtureB()->GetBody() == mProjectile))
+    {
+        mProjectile->SetLinearVelocity(mBounceFactor * mProjectile->GetLinearVelocity());
+    }
+}
+
+const std::vector<sf::Vector2f>& TrajectoryPredictor::predict(const sf::Vector2i& quantisedPull, const b2Vec2& position,
+    const b2Vec2& velocity, int maxPoints, int stepsPerPoint)
+{
+    if (!mIsBuilt || !mTemplate)
+    {
+        return mEmptyPath;
+    }
+
+    // Aiming mostly sits still or revisits nearby pulls, so most updates end here
+    std::uint64_t key = makeKey(quantisedPull, mTemplateType);
+    auto it = mPaths.find(key);
+    if (it != mPaths.end())
+    {
+        return it->second;
+    }
+
+    if (mPaths.size() >= MAX_CACHED_PATHS)
+    {
+        mPaths.clear();
+    }
+
+    std::vector<sf::Vector2f>& points = mPaths[key];
+    simulate(position, velocity, maxPoints, stepsPerPoint, points);
+    return points;
+}
+
+void TrajectoryPredictor::simulate(const b2Vec2& position, const b2Vec2& velocity, int maxPoints, int stepsPerPoint,
+    std::vector<sf::Vector2f>& points)
+{
+    points.clear();
+    points.reserve(maxPoints);
+
+    // A fresh body for every path, so no contact or warm start carries over and the last
+    // path's body is not mistaken for level geometry
+    if (mProjectile)
+    {
+        mWorld->DestroyBody(mProjectile);
+        mProjectile = nullptr;
+    }
+
+    // Free flight, integrated the way b2Island does it for a body with no contacts, until the
+    // next step could bring the projectile near any fixture of the level. Steps are counted
+    // in sub-steps, the way PhysicsWorld::update divides each fixed step.
+    const int subSteps = mSettings.subSteps;
+    const float h = TIME_STEP / subSteps;
+    const float inverseMass = mTemplate->GetMass() > 0.f ? 1.f / mTemplate->GetMass() : 0.f;
+    const b2Vec2 gravityVelocity = h * inverseMass * (mProjectileDef.gravityScale * mTemplate->GetMass() * mWorld->GetGravity());
+    const float damping = 1.f / (1.f + h * mProjectileDef.linearDamping);
+
+    b2Vec2 center = position + mTemplate->GetLocalCenter();
+    b2Vec2 currentVelocity = velocity;
+    int step = 0;
+    const int subStepsPerPoint = stepsPerPoint * subSteps;
+    const int totalSteps = maxPoints * subStepsPerPoint;
+
+    while (step < totalSteps)
+    {
+        b2Vec2 nextVelocity = damping * (currentVelocity + gravityVelocity);
+        b2Vec2 translation = h * nextVelocity;
+        if (b2Dot(translation, translation) > b2_maxTranslationSquared)
+        {
+            nextVelocity *= b2_maxTranslation / translation.Length();
+        }
+
+        if (isNearGeometry(center - mTemplate->GetLocalCenter(), h * nextVelocity))
+        {
+            break;
+        }
+
+        currentVelocity = nextVelocity;
+        center += h * currentVelocity;
+        ++step;
+
+        if (step % subStepsPerPoint == 0 && !addPoint(center - mTemplate->GetLocalCenter(), points))
+        {
+            return;
+        }
+    }
+
+    if (step >= totalSteps)
+    {
+        return;
+    }
+
+    // From here on the full world takes over
+    b2BodyDef bodyDef = mProjectileDef;
+    bodyDef.position = center - mTemplate->GetLocalCenter();
+    bodyDef.linearVelocity = currentVelocity;
+    mProjectile = mWorld->CreateBody(&bodyDef);
+    copyFixtures(mTemplate, mProjectile);
+
+    while (step < totalSteps)
+    {
+        mWorld->Step(h, mSettings.velocityIterations, mSettings.positionIterations);
+        ++step;
+
+        if (step % subStepsPerPoint == 0 && (!addPoint(mProjectile->GetPosition(), points) || !mProjectile->IsAwake()))
+        {
+            return;
+        }
+    }
+}
+
+bool TrajectoryPredictor::isNearGeometry(const b2Vec2& position, const b2Vec2& displacement)
+{
+    // The projectile's bounds swept over the next step, grown by the margin the broadphase
+    // fattens proxies by, so the world takes over before any contact could begin
+    b2AABB swept;
+    swept.lowerBound = position + mLocalBounds.lowerBound + b2Min(displacement, b2Vec2_zero);
+    swept.upperBound = position + mLocalBounds.upperBound + b2Max(displacement, b2Vec2_zero);
+    b2Vec2 margin(2.f * b2_aabbExtension, 2.f * b2_aabbExtension);
+    swept.lowerBound -= margin;
+    swept.upperBound += margin;
+
+    AnyFixtureQuery query;
+    mWorld->QueryAABB(&query, swept);
+    return query.found;
+}
+
+bool TrajectoryPredictor::addPoint(const b2Vec2& position, std::vector<sf::Vector2f>& points) const
+{
+    points.emplace_back(position.x * PhysicsWorld::SCALE, position.y * PhysicsWorld::SCALE);
+
+    bool outside = position.x < mBounds.lowerBound.x || position.x > mBounds.upperBound.x ||
+        position.y < mBounds.lowerBound.y || position.y > mBounds.upperBound.y;
+    return !outside;
+}
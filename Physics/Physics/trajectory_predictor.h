@@ -0,0 +1,81 @@
+#ifndef TRAJECTORY_PREDICTOR_H
+#define TRAJECTORY_PREDICTOR_H
+
+#include "solver_controller.h"
+#include <box2d/box2d.h>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Predicts where a launched projectile will go by stepping it alone through a private copy
+// of the level. Everything that is static or asleep is copied in as static geometry, so the
+// prediction includes gravity scale, damping, the projectile's size and every bounce, while
+// each step only solves one body. The copy and its allocators are kept between predictions.
+// It steps with the live world's solver settings and speeds the projectile up on every
+// contact it begins by the same factor the game does, so the path matches the real flight.
+//
+// Paths are memoised by quantised pull and projectile type until the level is copied again
+// or the solver settings change,
+// and the free flight before the projectile first nears any geometry is integrated directly
+// instead of through b2World::Step, so only the part of a path that touches something pays
+// for the full simulation.
+class TrajectoryPredictor : public b2ContactListener
+{
+public:
+    TrajectoryPredictor();
+    ~TrajectoryPredictor();
+
+    // Copies the resting level, leaving out awake bodies and the given projectile, and drops
+    // every memoised path. Needed again whenever the level has moved.
+    void rebuild(b2World& source, const b2Body* projectile, const b2AABB& bounds);
+    void invalidate() { mIsBuilt = false; mPaths.clear(); }
+    bool isBuilt() const { return mIsBuilt; }
+    // True when the last rebuild left out awake bodies, which will be somewhere else by now
+    bool hasSkippedAwakeBodies() const { return mSkippedAwakeBodies; }
+
+    // Takes the body settings of the projectile that will be launched and the factor its
+    // velocity is scaled by on each contact. Cheap when the type has not changed since the
+    // last call.
+    void setProjectile(const b2Body* projectile, int type, float bounceFactor);
+
+    // Iterations and sub-steps the live world currently steps with
+    void setSolverSettings(const SolverController::Settings& settings);
+
+    void BeginContact(b2Contact* contact) override;
+
+    // Positions in pixels after every stepsPerPoint fixed steps, stopping early once the
+    // projectile comes to rest or leaves the bounds. The position and velocity must follow
+    // from the quantised pull alone, which is what the result is memoised under.
+    const std::vector<sf::Vector2f>& predict(const sf::Vector2i& quantisedPull, const b2Vec2& position,
+        const b2Vec2& velocity, int maxPoints, int stepsPerPoint);
+
+    static const float TIME_STEP;
+
+private:
+    void clearWorld();
+    void simulate(const b2Vec2& position, const b2Vec2& velocity, int maxPoints, int stepsPerPoint,
+        std::vector<sf::Vector2f>& points);
+    bool isNearGeometry(const b2Vec2& position, const b2Vec2& displacement);
+    bool addPoint(const b2Vec2& position, std::vector<sf::Vector2f>& points) const;
+
+    std::unique_ptr<b2World> mWorld;
+    b2Body* mTemplate;   // Disabled copy of the projectile that every prediction is created from
+    b2Body* mProjectile; // The body of the last prediction
+    int mTemplateType;
+    float mBounceFactor;
+    SolverController::Settings mSettings;
+    b2BodyDef mProjectileDef;
+    b2AABB mLocalBounds; // Projectile fixtures around its origin
+    b2AABB mBounds;
+    bool mIsBuilt;
+    bool mSkippedAwakeBodies;
+
+    std::unordered_map<std::uint64_t, std::vector<sf::Vector2f>> mPaths;
+    std::vector<sf::Vector2f> mEmptyPath;
+
+    static const std::size_t MAX_CACHED_PATHS;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+
+// Lock-free single producer / single consumer triple buffer.
+// The producer always has a buffer to write into and the consumer always has the
+// most recently published one to read, so neither side ever waits for the other.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : mMiddle(2), mWriteIndex(0), mReadIndex(1) {}
+
+    // Producer side
+    T& getWriteBuffer() { return mBuffers[mWriteIndex]; }
+
+    void publish()
+    {
+        int previous = mMiddle.exchange(mWriteIndex | NEW_DATA_BIT, std::memory_order_acq_rel);
+        mWriteIndex = previous & INDEX_MASK;
+    }
+
+    // Consumer side, returns false when nothing new was published since the last call
+    bool consume()
+    {
+        if (!hasNewData())
+        {
+            return false;
+        }
+
+        int previous = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel);
+        mReadIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& getReadBuffer() const { return mBuffers[mReadIndex]; }
+
+    bool hasNewData() const { return (mMiddle.load(std::memory_order_acquire) & NEW_DATA_BIT) != 0; }
+
+private:
+    static const int INDEX_MASK = 0x3;
+    static const int NEW_DATA_BIT = 0x4;
+
+    std::array<T, 3> mBuffers;
+    std::atomic<int> mMiddle; // Index of the shared buffer plus the new data flag
+    int mWriteIndex;          // Only touched by the producer
+    int mReadIndex;           // Only touched by the consumer
+};
+
+#endif
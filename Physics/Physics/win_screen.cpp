@@ -1,20 +1,25 @@
 #include "win_screen.h"
 #include "game.h"
+#include "asset_cache.h"
 #include <iostream>
 
 WinScreen::WinScreen(sf::RenderWindow& window, Game& game)
     : Menu(window), mGame(game)
 {
-    if (!mBackgroundTexture.loadFromFile("dependencies/sprites/win.png"))
+    mBackgroundTexture = AssetCache::getInstance().getTexture("dependencies/sprites/win.png");
+    if (!mBackgroundTexture)
     {
         std::cout << "Failed to load win screen background image" << std::endl;
     }
-    mBackgroundSprite.setTexture(mBackgroundTexture);
+    else
+    {
+        mBackgroundSprite.setTexture(*mBackgroundTexture);
 
-    // Scale the background to fit the window
-    float scaleX = window.getSize().x / static_cast<float>(mBackgroundTexture.getSize().x);
-    float scaleY = window.getSize().y / static_cast<float>(mBackgroundTexture.getSize().y);
-    mBackgroundSprite.setScale(scaleX, scaleY);
+        // Scale the background to fit the window
+        float scaleX = window.getSize().x / static_cast<float>(mBackgroundTexture->getSize().x);
+        float scaleY = window.getSize().y / static_cast<float>(mBackgroundTexture->getSize().y);
+        mBackgroundSprite.setScale(scaleX, scaleY);
+    }
 
     addButton("Main Menu", [this]() { mGame.setState(Game::GameState::MainMenu); });
     addButton("Quit", [this]() { mGame.quitGame(); });
@@ -31,7 +36,7 @@ void WinScreen::handleEvent(const sf::Event& event)
 {
     if (event.type == sf::Event::MouseButtonPressed)
     {
-        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+        sf::Vector2f mousePos = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow), mWindow.getDefaultView());
         for (auto& button : mButtons)
         {
             if (button.text.getGlobalBounds().contains(mousePos))
@@ -47,11 +52,14 @@ void WinScreen::update(sf::Time deltaTime)
 {
 }
 
-void WinScreen::render()
+void WinScreen::render(RenderSnapshot& snapshot)
 {
-    mWindow.draw(mBackgroundSprite);
+    snapshot.draw(mBackgroundSprite);
+
+    mTextBatch.clear();
     for (const auto& button : mButtons)
     {
-        mWindow.draw(button.text);
+        mTextBatch.add(button.text);
     }
+    mTextBatch.draw(snapshot);
 }
\ No newline at end of file
@@ -12,11 +12,11 @@ public:
 
     void handleEvent(const sf::Event& event) override;
     void update(sf::Time deltaTime) override;
-    void render() override;
+    void render(RenderSnapshot& snapshot) override;
 
 private:
     sf::Sprite mBackgroundSprite;
-    sf::Texture mBackgroundTexture;
+    std::shared_ptr<const sf::Texture> mBackgroundTexture;
     Game& mGame;
 };
 